@@ -10,6 +10,7 @@
 
 #include "quran/renderer.h"
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -144,16 +145,203 @@ Java_org_digitalkhatt_quran_renderer_QuranRenderer_nativeDrawPage(
     buffer.stride = info.stride;
     buffer.format = QURAN_PIXEL_FORMAT_RGBA8888;
 
-    QuranRenderConfig config;
+    QuranRenderConfig config = {};
     config.tajweed = tajweed;
     config.justify = justify;
     config.fontScale = fontScale;
+    config.backgroundColor = 0xFFFFFFFF;
+    config.topMarginLines = -1.0f;
 
     quran_renderer_draw_page(g_renderer, &buffer, pageIndex, &config);
 
     AndroidBitmap_unlockPixels(env, bitmap);
 }
 
+JNIEXPORT jboolean JNICALL
+Java_org_digitalkhatt_quran_renderer_QuranRenderer_nativeDrawPagePreview(
+    JNIEnv *env,
+    jobject thiz,
+    jobject bitmap,
+    jint pageIndex,
+    jboolean tajweed,
+    jfloat fontScale
+) {
+    if (!g_renderer) {
+        LOGE("Renderer not initialized");
+        return JNI_FALSE;
+    }
+
+    AndroidBitmapInfo info;
+    if (AndroidBitmap_getInfo(env, bitmap, &info) != ANDROID_BITMAP_RESULT_SUCCESS) {
+        LOGE("Failed to get bitmap info");
+        return JNI_FALSE;
+    }
+
+    if (info.format != ANDROID_BITMAP_FORMAT_RGBA_8888) {
+        LOGE("Bitmap format must be RGBA_8888");
+        return JNI_FALSE;
+    }
+
+    void *pixels;
+    if (AndroidBitmap_lockPixels(env, bitmap, &pixels) != ANDROID_BITMAP_RESULT_SUCCESS) {
+        LOGE("Failed to lock bitmap pixels");
+        return JNI_FALSE;
+    }
+
+    QuranPixelBuffer buffer;
+    buffer.pixels = pixels;
+    buffer.width = info.width;
+    buffer.height = info.height;
+    buffer.stride = info.stride;
+    buffer.format = QURAN_PIXEL_FORMAT_RGBA8888;
+
+    QuranRenderConfig config = {};
+    config.tajweed = tajweed;
+    config.justify = true;
+    config.fontScale = fontScale;
+    config.backgroundColor = 0xFFFFFFFF;
+    config.topMarginLines = -1.0f;
+
+    QuranRenderPhase drawn = quran_renderer_draw_page_phase(g_renderer, &buffer, pageIndex, &config,
+                                                            QURAN_RENDER_PREVIEW);
+
+    AndroidBitmap_unlockPixels(env, bitmap);
+    return drawn == QURAN_RENDER_PREVIEW ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT void JNICALL
+Java_org_digitalkhatt_quran_renderer_QuranRenderer_nativeDrawSpread(
+    JNIEnv *env,
+    jobject thiz,
+    jobject bitmap,
+    jint rightPage,
+    jboolean tajweed,
+    jboolean justify,
+    jfloat fontScale
+) {
+    if (!g_renderer) {
+        LOGE("Renderer not initialized");
+        return;
+    }
+
+    AndroidBitmapInfo info;
+    if (AndroidBitmap_getInfo(env, bitmap, &info) != ANDROID_BITMAP_RESULT_SUCCESS) {
+        LOGE("Failed to get bitmap info");
+        return;
+    }
+
+    if (info.format != ANDROID_BITMAP_FORMAT_RGBA_8888) {
+        LOGE("Bitmap format must be RGBA_8888");
+        return;
+    }
+
+    void *pixels;
+    if (AndroidBitmap_lockPixels(env, bitmap, &pixels) != ANDROID_BITMAP_RESULT_SUCCESS) {
+        LOGE("Failed to lock bitmap pixels");
+        return;
+    }
+
+    QuranPixelBuffer buffer;
+    buffer.pixels = pixels;
+    buffer.width = info.width;
+    buffer.height = info.height;
+    buffer.stride = info.stride;
+    buffer.format = QURAN_PIXEL_FORMAT_RGBA8888;
+
+    QuranRenderConfig config = {};
+    config.tajweed = tajweed;
+    config.justify = justify;
+    config.fontScale = fontScale;
+    config.backgroundColor = 0xFFFFFFFF;
+    config.topMarginLines = -1.0f;
+
+    quran_renderer_draw_spread(g_renderer, &buffer, rightPage, &config);
+
+    AndroidBitmap_unlockPixels(env, bitmap);
+}
+
+JNIEXPORT jintArray JNICALL
+Java_org_digitalkhatt_quran_renderer_QuranRenderer_nativeMeasureAyahImage(
+    JNIEnv *env,
+    jobject thiz,
+    jint surahNumber,
+    jint firstAyah,
+    jint lastAyah,
+    jint pageWidth,
+    jint padding,
+    jboolean tajweed
+) {
+    if (!g_renderer) return nullptr;
+
+    QuranRenderConfig config = {};
+    config.tajweed = tajweed;
+    config.justify = true;
+    config.backgroundColor = 0xFFFFFFFF;
+
+    int size[2];
+    if (!quran_renderer_measure_ayah_image(g_renderer, surahNumber, firstAyah, lastAyah,
+                                           pageWidth, padding, &config, &size[0], &size[1])) {
+        return nullptr;
+    }
+
+    jintArray result = env->NewIntArray(2);
+    env->SetIntArrayRegion(result, 0, 2, size);
+    return result;
+}
+
+JNIEXPORT jboolean JNICALL
+Java_org_digitalkhatt_quran_renderer_QuranRenderer_nativeDrawAyahImage(
+    JNIEnv *env,
+    jobject thiz,
+    jobject bitmap,
+    jint surahNumber,
+    jint firstAyah,
+    jint lastAyah,
+    jint pageWidth,
+    jint padding,
+    jboolean tajweed
+) {
+    if (!g_renderer) {
+        LOGE("Renderer not initialized");
+        return JNI_FALSE;
+    }
+
+    AndroidBitmapInfo info;
+    if (AndroidBitmap_getInfo(env, bitmap, &info) != ANDROID_BITMAP_RESULT_SUCCESS) {
+        LOGE("Failed to get bitmap info");
+        return JNI_FALSE;
+    }
+
+    if (info.format != ANDROID_BITMAP_FORMAT_RGBA_8888) {
+        LOGE("Bitmap format must be RGBA_8888");
+        return JNI_FALSE;
+    }
+
+    void *pixels;
+    if (AndroidBitmap_lockPixels(env, bitmap, &pixels) != ANDROID_BITMAP_RESULT_SUCCESS) {
+        LOGE("Failed to lock bitmap pixels");
+        return JNI_FALSE;
+    }
+
+    QuranPixelBuffer buffer;
+    buffer.pixels = pixels;
+    buffer.width = info.width;
+    buffer.height = info.height;
+    buffer.stride = info.stride;
+    buffer.format = QURAN_PIXEL_FORMAT_RGBA8888;
+
+    QuranRenderConfig config = {};
+    config.tajweed = tajweed;
+    config.justify = true;
+    config.backgroundColor = 0xFFFFFFFF;
+
+    bool ok = quran_renderer_draw_ayah_image(g_renderer, &buffer, surahNumber, firstAyah, lastAyah,
+                                             pageWidth, padding, &config);
+
+    AndroidBitmap_unlockPixels(env, bitmap);
+    return ok ? JNI_TRUE : JNI_FALSE;
+}
+
 JNIEXPORT jint JNICALL
 Java_org_digitalkhatt_quran_renderer_QuranRenderer_nativeGetPageCount(
     JNIEnv *env,
@@ -162,6 +350,133 @@ Java_org_digitalkhatt_quran_renderer_QuranRenderer_nativeGetPageCount(
     return g_renderer ? quran_renderer_get_page_count(g_renderer) : 0;
 }
 
+JNIEXPORT jobject JNICALL
+Java_org_digitalkhatt_quran_renderer_QuranRenderer_nativeGetPageMetrics(
+    JNIEnv *env,
+    jobject thiz,
+    jint pageIndex,
+    jint width,
+    jint height
+) {
+    if (!g_renderer) return nullptr;
+    
+    QuranPageMetrics metrics;
+    QuranLineMetrics lines[15];
+    int lineCount = quran_renderer_get_page_metrics(g_renderer, pageIndex, width, height,
+                                                    nullptr, &metrics, lines, 15);
+    if (lineCount < 0) return nullptr;
+    lineCount = std::min(lineCount, 15);
+    
+    jclass lineCls = env->FindClass("org/digitalkhatt/quran/renderer/LineMetrics");
+    if (!lineCls) return nullptr;
+    jmethodID lineConstructor = env->GetMethodID(lineCls, "<init>", "(IFFFZIFFFF)V");
+    if (!lineConstructor) return nullptr;
+    
+    jclass pageCls = env->FindClass("org/digitalkhatt/quran/renderer/PageMetrics");
+    if (!pageCls) return nullptr;
+    jmethodID pageConstructor = env->GetMethodID(pageCls, "<init>",
+        "(IIIIF[Lorg/digitalkhatt/quran/renderer/LineMetrics;)V");
+    if (!pageConstructor) return nullptr;
+    
+    jobjectArray lineArray = env->NewObjectArray(lineCount, lineCls, nullptr);
+    for (int i = 0; i < lineCount; i++) {
+        const QuranLineMetrics& line = lines[i];
+        jobject lineObj = env->NewObject(lineCls, lineConstructor,
+            static_cast<jint>(line.kind), line.baseline, line.left, line.right,
+            static_cast<jboolean>(line.hasSurahHeader), line.surahNumber,
+            line.headerX, line.headerY, line.headerWidth, line.headerHeight);
+        env->SetObjectArrayElement(lineArray, i, lineObj);
+        env->DeleteLocalRef(lineObj);
+    }
+    
+    return env->NewObject(pageCls, pageConstructor,
+        metrics.charHeight, metrics.interLine, metrics.yStart, metrics.xPadding,
+        metrics.scale, lineArray);
+}
+
+static jobjectArray newClusterArray(JNIEnv *env, const std::vector<QuranCluster>& clusters,
+                                    const std::vector<int>* indexMap) {
+    jclass cls = env->FindClass("org/digitalkhatt/quran/renderer/TextCluster");
+    if (!cls) return nullptr;
+    
+    jmethodID constructor = env->GetMethodID(cls, "<init>", "(IIFF)V");
+    if (!constructor) return nullptr;
+    
+    jobjectArray result = env->NewObjectArray(static_cast<jsize>(clusters.size()), cls, nullptr);
+    for (size_t i = 0; i < clusters.size(); i++) {
+        const QuranCluster& cluster = clusters[i];
+        int start = indexMap ? (*indexMap)[cluster.byteStart] : cluster.byteStart;
+        int end = indexMap ? (*indexMap)[cluster.byteEnd] : cluster.byteEnd;
+        jobject obj = env->NewObject(cls, constructor, start, end, cluster.left, cluster.right);
+        env->SetObjectArrayElement(result, static_cast<jsize>(i), obj);
+        env->DeleteLocalRef(obj);
+    }
+    
+    return result;
+}
+
+JNIEXPORT jobjectArray JNICALL
+Java_org_digitalkhatt_quran_renderer_QuranRenderer_nativeGetLineClusters(
+    JNIEnv *env,
+    jobject thiz,
+    jint pageIndex,
+    jint lineIndex,
+    jint width,
+    jint height,
+    jboolean tajweed,
+    jboolean justify
+) {
+    if (!g_renderer) return nullptr;
+    
+    QuranRenderConfig config = {};
+    config.tajweed = tajweed;
+    config.justify = justify;
+    
+    int count = quran_renderer_get_line_clusters(g_renderer, pageIndex, lineIndex, width, height,
+                                                 &config, nullptr, 0);
+    if (count < 0) return nullptr;
+    
+    std::vector<QuranCluster> clusters(count);
+    quran_renderer_get_line_clusters(g_renderer, pageIndex, lineIndex, width, height,
+                                     &config, clusters.data(), count);
+    return newClusterArray(env, clusters, nullptr);
+}
+
+JNIEXPORT jobjectArray JNICALL
+Java_org_digitalkhatt_quran_renderer_QuranRenderer_nativeGetTextClusters(
+    JNIEnv *env,
+    jobject thiz,
+    jstring text,
+    jint fontSize
+) {
+    if (!g_renderer) return nullptr;
+    
+    const char *textStr = env->GetStringUTFChars(text, nullptr);
+    int length = env->GetStringUTFLength(text);
+    
+    // Map UTF-8 byte offsets to Java char indices
+    std::vector<int> charIndex(length + 1);
+    int units = 0;
+    for (int i = 0; i < length; i++) {
+        charIndex[i] = units;
+        unsigned char c = static_cast<unsigned char>(textStr[i]);
+        if ((c & 0xC0) != 0x80) {
+            units += (c >= 0xF0) ? 2 : 1;
+        }
+    }
+    charIndex[length] = units;
+    
+    // A cluster spans at least one byte, so length bounds the count (one shaping pass)
+    std::vector<QuranCluster> clusters(length);
+    int count = quran_renderer_get_text_clusters(g_renderer, textStr, length, fontSize,
+                                                 clusters.data(), length);
+    env->ReleaseStringUTFChars(text, textStr);
+    
+    if (count < 0) return nullptr;
+    clusters.resize(std::min(count, length));
+    return newClusterArray(env, clusters, &charIndex);
+}
+
 // Surah/Ayah API - these don't require renderer initialization
 
 JNIEXPORT jint JNICALL
@@ -228,6 +543,91 @@ Java_org_digitalkhatt_quran_renderer_QuranRenderer_nativeGetPageLocation(
     return env->NewObject(cls, constructor, loc.surahNumber, loc.ayahNumber, loc.pageIndex);
 }
 
+static jobject newAyahLocation(JNIEnv *env, const QuranAyahLocation& loc) {
+    jclass cls = env->FindClass("org/digitalkhatt/quran/renderer/AyahLocation");
+    if (!cls) return nullptr;
+    
+    jmethodID constructor = env->GetMethodID(cls, "<init>", "(III)V");
+    if (!constructor) return nullptr;
+    
+    return env->NewObject(cls, constructor, loc.surahNumber, loc.ayahNumber, loc.pageIndex);
+}
+
+JNIEXPORT jobject JNICALL
+Java_org_digitalkhatt_quran_renderer_QuranRenderer_nativeGetJuzLocation(
+    JNIEnv *env,
+    jobject thiz,
+    jint juzNumber
+) {
+    QuranAyahLocation loc;
+    if (!quran_renderer_get_juz_location(juzNumber, &loc)) {
+        return nullptr;
+    }
+    return newAyahLocation(env, loc);
+}
+
+JNIEXPORT jobject JNICALL
+Java_org_digitalkhatt_quran_renderer_QuranRenderer_nativeGetHizbLocation(
+    JNIEnv *env,
+    jobject thiz,
+    jint hizbNumber
+) {
+    QuranAyahLocation loc;
+    if (!quran_renderer_get_hizb_location(hizbNumber, &loc)) {
+        return nullptr;
+    }
+    return newAyahLocation(env, loc);
+}
+
+JNIEXPORT jobject JNICALL
+Java_org_digitalkhatt_quran_renderer_QuranRenderer_nativeGetRubLocation(
+    JNIEnv *env,
+    jobject thiz,
+    jint rubNumber
+) {
+    QuranAyahLocation loc;
+    if (!quran_renderer_get_rub_location(rubNumber, &loc)) {
+        return nullptr;
+    }
+    return newAyahLocation(env, loc);
+}
+
+JNIEXPORT jint JNICALL
+Java_org_digitalkhatt_quran_renderer_QuranRenderer_nativeGetJuzStartPage(
+    JNIEnv *env,
+    jobject thiz,
+    jint juzNumber
+) {
+    return quran_renderer_get_juz_start_page(juzNumber);
+}
+
+JNIEXPORT jint JNICALL
+Java_org_digitalkhatt_quran_renderer_QuranRenderer_nativeGetPageJuz(
+    JNIEnv *env,
+    jobject thiz,
+    jint pageIndex
+) {
+    return quran_renderer_get_page_juz(pageIndex);
+}
+
+JNIEXPORT jint JNICALL
+Java_org_digitalkhatt_quran_renderer_QuranRenderer_nativeGetPageHizb(
+    JNIEnv *env,
+    jobject thiz,
+    jint pageIndex
+) {
+    return quran_renderer_get_page_hizb(pageIndex);
+}
+
+JNIEXPORT jint JNICALL
+Java_org_digitalkhatt_quran_renderer_QuranRenderer_nativeGetPageRub(
+    JNIEnv *env,
+    jobject thiz,
+    jint pageIndex
+) {
+    return quran_renderer_get_page_rub(pageIndex);
+}
+
 JNIEXPORT jobject JNICALL
 Java_org_digitalkhatt_quran_renderer_QuranRenderer_nativeGetSurahInfo(
     JNIEnv *env,
@@ -257,4 +657,50 @@ Java_org_digitalkhatt_quran_renderer_QuranRenderer_nativeGetSurahInfo(
         info.revelationOrder, info.rukuCount);
 }
 
+JNIEXPORT jstring JNICALL
+Java_org_digitalkhatt_quran_renderer_QuranRenderer_nativeGetAyahText(
+    JNIEnv *env,
+    jobject thiz,
+    jint surahNumber,
+    jint ayahNumber
+) {
+    int length = quran_renderer_get_ayah_text(surahNumber, ayahNumber, nullptr, 0);
+    if (length < 0) return nullptr;
+    
+    std::vector<char> text(length + 1);
+    quran_renderer_get_ayah_text(surahNumber, ayahNumber, text.data(), static_cast<int>(text.size()));
+    return env->NewStringUTF(text.data());
+}
+
+JNIEXPORT jobjectArray JNICALL
+Java_org_digitalkhatt_quran_renderer_QuranRenderer_nativeSearch(
+    JNIEnv *env,
+    jobject thiz,
+    jstring query,
+    jint maxHits
+) {
+    jclass cls = env->FindClass("org/digitalkhatt/quran/renderer/SearchHit");
+    if (!cls) return nullptr;
+    
+    jmethodID constructor = env->GetMethodID(cls, "<init>", "(IIIIII)V");
+    if (!constructor) return nullptr;
+    
+    const char *queryStr = env->GetStringUTFChars(query, nullptr);
+    std::vector<QuranSearchHit> hits(maxHits > 0 ? maxHits : 0);
+    int total = quran_renderer_search(queryStr, -1, hits.data(), static_cast<int>(hits.size()));
+    env->ReleaseStringUTFChars(query, queryStr);
+    
+    int count = std::min(std::max(total, 0), static_cast<int>(hits.size()));
+    jobjectArray result = env->NewObjectArray(count, cls, nullptr);
+    for (int i = 0; i < count; i++) {
+        jobject hit = env->NewObject(cls, constructor,
+            hits[i].pageIndex, hits[i].lineIndex, hits[i].byteStart, hits[i].byteEnd,
+            hits[i].surahNumber, hits[i].ayahNumber);
+        env->SetObjectArrayElement(result, i, hit);
+        env->DeleteLocalRef(hit);
+    }
+    
+    return result;
+}
+
 } // extern "C"
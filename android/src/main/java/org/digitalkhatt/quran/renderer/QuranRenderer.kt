@@ -27,6 +27,64 @@ data class AyahLocation(
     val pageIndex: Int         // Page index (0-603)
 )
 
+/**
+ * Search hit data class.
+ *
+ * Byte offsets are relative to the UTF-8 text of the line.
+ */
+data class SearchHit(
+    val pageIndex: Int,        // Page index (0-603)
+    val lineIndex: Int,        // Line within the page (0-14)
+    val byteStart: Int,        // Start of the match in the line text (bytes)
+    val byteEnd: Int,          // End of the match in the line text (bytes, exclusive)
+    val surahNumber: Int,      // Surah containing the match (1-114)
+    val ayahNumber: Int        // Ayah containing the match (1-based)
+)
+
+/**
+ * Line geometry data class (pixels).
+ *
+ * Text is right-aligned at [right]; when [hasSurahHeader] is set the
+ * header rect replaces the text line.
+ */
+data class LineMetrics(
+    val kind: Int,             // 0 = ayah text, 1 = surah name, 2 = basmala
+    val baseline: Float,
+    val left: Float,
+    val right: Float,
+    val hasSurahHeader: Boolean,
+    val surahNumber: Int,      // Surah of the header, or -1
+    val headerX: Float,
+    val headerY: Float,
+    val headerWidth: Float,
+    val headerHeight: Float
+)
+
+/**
+ * Page layout data class (pixels), as used by drawPage.
+ */
+data class PageMetrics(
+    val charHeight: Int,       // Font size
+    val interLine: Int,        // Distance between baselines
+    val yStart: Int,           // Baseline of the first line
+    val xPadding: Int,         // Horizontal margin on each side
+    val scale: Float,          // Pixels per font unit
+    val lines: Array<LineMetrics>
+)
+
+/**
+ * Cluster extents data class (a letter with its marks, or a ligature).
+ *
+ * For page lines, start/end are byte offsets in the line's UTF-8 text (like
+ * SearchHit); for getTextClusters they are char indices in the input string.
+ */
+data class TextCluster(
+    val start: Int,
+    val end: Int,              // Exclusive
+    val left: Float,           // Pixels
+    val right: Float
+)
+
 /**
  * Available DigitalKhatt font styles.
  * 
@@ -178,6 +236,33 @@ class QuranRenderer private constructor() {
         nativeDrawPage(bitmap, pageIndex, tajweed, justify, fontScale)
     }
 
+    /**
+     * Render a fast preview of a page (no kashida, spaces stretched only).
+     *
+     * Use it for frames drawn while the page moves or resizes (flings,
+     * font-size sliders, resize drags), then call [drawPage] with the same
+     * arguments once the interaction is idle. Line breaks and heights match
+     * the final frame.
+     *
+     * @param bitmap Bitmap to render into (must be ARGB_8888)
+     * @param pageIndex Page index (0-603)
+     * @param tajweed Enable tajweed coloring
+     * @param fontScale Font size scale factor (1.0 = default, range: 0.5-2.0)
+     * @return true if the frame is a preview that [drawPage] should replace
+     */
+    fun drawPagePreview(
+        bitmap: Bitmap,
+        pageIndex: Int,
+        tajweed: Boolean = true,
+        fontScale: Float = 1.0f
+    ): Boolean {
+        require(initialized) { "QuranRenderer not initialized" }
+        require(bitmap.config == Bitmap.Config.ARGB_8888) { "Bitmap must be ARGB_8888" }
+        require(pageIndex in 0 until pageCount) { "Invalid page index: $pageIndex" }
+        
+        return nativeDrawPagePreview(bitmap, pageIndex, tajweed, fontScale)
+    }
+
     /**
      * Create a new bitmap and render a page into it.
      * 
@@ -202,12 +287,86 @@ class QuranRenderer private constructor() {
         return bitmap
     }
 
+    /**
+     * Render a two-page spread (landscape tablets) into one bitmap.
+     *
+     * The right half shows [rightPage], the left half its facing page
+     * (rightPage + 1), with a gutter between them. Both halves render in
+     * parallel on multi-core devices. Spreads of the printed mushaf start on
+     * even page indices.
+     *
+     * @param bitmap Bitmap to render into (must be ARGB_8888)
+     * @param rightPage Page index shown on the right (0-603)
+     * @param tajweed Enable tajweed coloring
+     * @param justify Enable line justification
+     * @param fontScale Font size scale factor (1.0 = default, range: 0.5-2.0)
+     */
+    fun drawSpread(
+        bitmap: Bitmap,
+        rightPage: Int,
+        tajweed: Boolean = true,
+        justify: Boolean = true,
+        fontScale: Float = 1.0f
+    ) {
+        require(initialized) { "QuranRenderer not initialized" }
+        require(bitmap.config == Bitmap.Config.ARGB_8888) { "Bitmap must be ARGB_8888" }
+        require(rightPage in 0 until pageCount) { "Invalid page index: $rightPage" }
+        
+        nativeDrawSpread(bitmap, rightPage, tajweed, justify, fontScale)
+    }
+
     /**
      * Get total number of pages.
      */
     val pageCount: Int
         get() = if (initialized) nativeGetPageCount() else 0
 
+    /**
+     * Get the layout of a page without rendering it.
+     * 
+     * @param pageIndex Page index (0-603)
+     * @param width Bitmap width in pixels
+     * @param height Bitmap height in pixels
+     * @return PageMetrics or null if not initialized or invalid arguments
+     */
+    fun getPageMetrics(pageIndex: Int, width: Int, height: Int): PageMetrics? {
+        if (!initialized) return null
+        return nativeGetPageMetrics(pageIndex, width, height)
+    }
+
+    /**
+     * Render an ayah or ayah range into a tightly cropped bitmap for sharing.
+     *
+     * The ayahs keep their mushaf lines and justification, as on a page of
+     * [pageWidth] pixels; only their own glyphs are rendered.
+     *
+     * @param surahNumber Surah number (1-114)
+     * @param firstAyah First ayah (1-based)
+     * @param lastAyah Last ayah, inclusive
+     * @param pageWidth Width of the virtual page in pixels (sets the font size)
+     * @param padding Margin around the text in pixels
+     * @param tajweed Enable tajweed coloring
+     * @return Cropped bitmap, or null if not initialized or the range is invalid
+     */
+    fun renderAyahImage(
+        surahNumber: Int,
+        firstAyah: Int,
+        lastAyah: Int = firstAyah,
+        pageWidth: Int = 1440,
+        padding: Int = 32,
+        tajweed: Boolean = true
+    ): Bitmap? {
+        if (!initialized) return null
+        val size = nativeMeasureAyahImage(surahNumber, firstAyah, lastAyah, pageWidth, padding, tajweed)
+            ?: return null
+        val bitmap = Bitmap.createBitmap(size[0], size[1], Bitmap.Config.ARGB_8888)
+        if (!nativeDrawAyahImage(bitmap, surahNumber, firstAyah, lastAyah, pageWidth, padding, tajweed)) {
+            bitmap.recycle()
+            return null
+        }
+        return bitmap
+    }
+
     // ============================================================================
     // Surah/Ayah API - These work without renderer initialization
     // ============================================================================
@@ -275,6 +434,142 @@ class QuranRenderer private constructor() {
         return nativeGetPageLocation(pageIndex)
     }
 
+    /**
+     * Get the start of a juz.
+     * 
+     * @param juzNumber Juz number (1-30)
+     * @return AyahLocation or null if invalid juz number
+     */
+    fun getJuzLocation(juzNumber: Int): AyahLocation? {
+        return nativeGetJuzLocation(juzNumber)
+    }
+
+    /**
+     * Get the start of a hizb.
+     * 
+     * @param hizbNumber Hizb number (1-60)
+     * @return AyahLocation or null if invalid hizb number
+     */
+    fun getHizbLocation(hizbNumber: Int): AyahLocation? {
+        return nativeGetHizbLocation(hizbNumber)
+    }
+
+    /**
+     * Get the start of a rub al-hizb (hizb quarter).
+     * 
+     * @param rubNumber Rub number (1-240)
+     * @return AyahLocation or null if invalid rub number
+     */
+    fun getRubLocation(rubNumber: Int): AyahLocation? {
+        return nativeGetRubLocation(rubNumber)
+    }
+
+    /**
+     * Get the page index where a juz starts.
+     * 
+     * @param juzNumber Juz number (1-30)
+     * @return Page index (0-603), or -1 if invalid
+     */
+    fun getJuzStartPage(juzNumber: Int): Int {
+        return nativeGetJuzStartPage(juzNumber)
+    }
+
+    /**
+     * Get the juz a page belongs to (the last juz starting on or before it).
+     * 
+     * @param pageIndex Page index (0-603)
+     * @return Juz number (1-30), or -1 if invalid
+     */
+    fun getPageJuz(pageIndex: Int): Int {
+        return nativeGetPageJuz(pageIndex)
+    }
+
+    /**
+     * Get the hizb a page belongs to (the last hizb starting on or before it).
+     * 
+     * @param pageIndex Page index (0-603)
+     * @return Hizb number (1-60), or -1 if invalid
+     */
+    fun getPageHizb(pageIndex: Int): Int {
+        return nativeGetPageHizb(pageIndex)
+    }
+
+    /**
+     * Get the rub al-hizb a page belongs to (the last rub starting on or before it).
+     * 
+     * @param pageIndex Page index (0-603)
+     * @return Rub number (1-240), or -1 if invalid
+     */
+    fun getPageRub(pageIndex: Int): Int {
+        return nativeGetPageRub(pageIndex)
+    }
+
+    /**
+     * Get the clusters of a page line as drawn by drawPage.
+     * 
+     * @param pageIndex Page index (0-603)
+     * @param lineIndex Line within the page
+     * @param width Bitmap width in pixels
+     * @param height Bitmap height in pixels
+     * @param tajweed Tajweed setting used for drawing
+     * @param justify Justify setting used for drawing
+     * @return Clusters in logical order, x in bitmap coordinates
+     */
+    fun getLineClusters(
+        pageIndex: Int,
+        lineIndex: Int,
+        width: Int,
+        height: Int,
+        tajweed: Boolean = true,
+        justify: Boolean = true
+    ): Array<TextCluster> {
+        if (!initialized) return emptyArray()
+        return nativeGetLineClusters(pageIndex, lineIndex, width, height, tajweed, justify) ?: emptyArray()
+    }
+
+    /**
+     * Get the clusters of a single line of text, shaped once.
+     * 
+     * Use for selection handles and caret movement instead of measuring
+     * prefixes. x is relative to the left edge of the text.
+     * 
+     * @param text Arabic text
+     * @param fontSize Font size in pixels
+     * @return Clusters in logical order, with char indices into text
+     */
+    fun getTextClusters(text: String, fontSize: Int): Array<TextCluster> {
+        if (!initialized) return emptyArray()
+        return nativeGetTextClusters(text, fontSize) ?: emptyArray()
+    }
+
+    /**
+     * Get the exact mushaf text of an ayah.
+     *
+     * Line breaks inside the ayah are replaced by spaces. The text ends
+     * with the ayah's end marker.
+     *
+     * @param surahNumber Surah number (1-114)
+     * @param ayahNumber Ayah number within surah (1-based)
+     * @return Ayah text or null if invalid
+     */
+    fun getAyahText(surahNumber: Int, ayahNumber: Int): String? {
+        return nativeGetAyahText(surahNumber, ayahNumber)
+    }
+
+    /**
+     * Diacritic-insensitive search over the Quran text.
+     *
+     * Harakat, Quranic marks and tatweel are ignored and all alef forms
+     * match a bare alef. The index is built on the first call.
+     *
+     * @param query Search text
+     * @param maxHits Maximum number of hits to return
+     * @return Hits in mushaf order
+     */
+    fun search(query: String, maxHits: Int = 100): Array<SearchHit> {
+        return nativeSearch(query, maxHits) ?: emptyArray()
+    }
+
     /**
      * Release native resources.
      */
@@ -290,7 +585,14 @@ class QuranRenderer private constructor() {
     private external fun nativeInit(assetManager: AssetManager, fontPath: String): Boolean
     private external fun nativeDestroy()
     private external fun nativeDrawPage(bitmap: Bitmap, pageIndex: Int, tajweed: Boolean, justify: Boolean, fontScale: Float)
+    private external fun nativeDrawPagePreview(bitmap: Bitmap, pageIndex: Int, tajweed: Boolean, fontScale: Float): Boolean
+    private external fun nativeDrawSpread(bitmap: Bitmap, rightPage: Int, tajweed: Boolean, justify: Boolean, fontScale: Float)
     private external fun nativeGetPageCount(): Int
+    private external fun nativeMeasureAyahImage(surahNumber: Int, firstAyah: Int, lastAyah: Int, pageWidth: Int, padding: Int, tajweed: Boolean): IntArray?
+    private external fun nativeDrawAyahImage(bitmap: Bitmap, surahNumber: Int, firstAyah: Int, lastAyah: Int, pageWidth: Int, padding: Int, tajweed: Boolean): Boolean
+    private external fun nativeGetPageMetrics(pageIndex: Int, width: Int, height: Int): PageMetrics?
+    private external fun nativeGetLineClusters(pageIndex: Int, lineIndex: Int, width: Int, height: Int, tajweed: Boolean, justify: Boolean): Array<TextCluster>?
+    private external fun nativeGetTextClusters(text: String, fontSize: Int): Array<TextCluster>?
     
     // Surah/Ayah native methods
     private external fun nativeGetSurahCount(): Int
@@ -300,4 +602,17 @@ class QuranRenderer private constructor() {
     private external fun nativeGetSurahStartPage(surahNumber: Int): Int
     private external fun nativeGetAyahPage(surahNumber: Int, ayahNumber: Int): Int
     private external fun nativeGetPageLocation(pageIndex: Int): AyahLocation?
+    
+    // Juz/hizb native methods
+    private external fun nativeGetJuzLocation(juzNumber: Int): AyahLocation?
+    private external fun nativeGetHizbLocation(hizbNumber: Int): AyahLocation?
+    private external fun nativeGetRubLocation(rubNumber: Int): AyahLocation?
+    private external fun nativeGetJuzStartPage(juzNumber: Int): Int
+    private external fun nativeGetPageJuz(pageIndex: Int): Int
+    private external fun nativeGetPageHizb(pageIndex: Int): Int
+    private external fun nativeGetPageRub(pageIndex: Int): Int
+    
+    // Ayah text / search native methods
+    private external fun nativeGetAyahText(surahNumber: Int, ayahNumber: Int): String?
+    private external fun nativeSearch(query: String, maxHits: Int): Array<SearchHit>?
 }
@@ -42,6 +42,42 @@ typedef struct {
     size_t size;            // Size in bytes
 } QuranFontData;
 
+/**
+ * Render quality level
+ *
+ * Trades fidelity for speed per device tier. Line breaks, justification and
+ * glyph positions are the same at every level; only how glyphs are filled
+ * changes.
+ */
+typedef enum {
+    QURAN_QUALITY_DEFAULT = 0,  // QURAN_QUALITY_HIGH
+    QURAN_QUALITY_LOW = 1,      // No anti-aliasing, coarse curves, one fill per glyph, whole-pixel positions
+    QURAN_QUALITY_MEDIUM = 2,   // Anti-aliased, fine curves, one fill per glyph, 1/4-pixel positions
+    QURAN_QUALITY_HIGH = 3,     // Anti-aliased, exact curves, all COLR layers, 1/16-pixel positions (print)
+    QURAN_QUALITY_ZOOM = 4,     // One fill per glyph sampled from cached distance fields (pinch-zoom frames)
+} QuranRenderQuality;
+
+/**
+ * How a draw call prepares the buffer before drawing
+ *
+ * QURAN_CLEAR_DIRTY is for a buffer that is drawn into again and again (a
+ * reading view's page bitmap): the renderer remembers what its last such draw
+ * into that buffer inked and refills only that rectangle with the background.
+ * Another draw into the buffer through the same renderer, a different size or
+ * format, or a background change falls back to a full clear, as does a
+ * background that is not opaque.
+ *
+ * The renderer only sees its own draws. A buffer drawn with DIRTY must be
+ * owned by that renderer alone: if the host draws into it or another renderer
+ * (e.g. one per font) shares it, call quran_renderer_forget_buffer before the
+ * next DIRTY draw, or stale ink stays behind.
+ */
+typedef enum {
+    QURAN_CLEAR_FULL = 0,       // Fill the whole buffer with the background (default)
+    QURAN_CLEAR_NONE = 1,       // Buffer already holds the background (e.g. recycled from a page pool)
+    QURAN_CLEAR_DIRTY = 2,      // Refill only what the previous QURAN_CLEAR_DIRTY draw into this buffer inked
+} QuranClearMode;
+
 /**
  * Renderer configuration
  */
@@ -54,6 +90,8 @@ typedef struct {
     bool useForeground; // If true, use foreground color when COLR requests use_foreground
     float lineHeightDivisor;  // EXTRA line spacing = height / lineHeightDivisor (0 = no extra spacing)
     float topMarginLines;     // Top margin in line-heights (0 = no margin, -1 = auto: 0 for all pages)
+    QuranRenderQuality quality; // Render quality (0 = default)
+    QuranClearMode clearMode;   // Background clear before drawing (0 = full)
 } QuranRenderConfig;
 
 /**
@@ -98,11 +136,390 @@ void quran_renderer_draw_page(
     const QuranRenderConfig* config
 );
 
+/**
+ * Forget what the last QURAN_CLEAR_DIRTY draw inked in a buffer
+ *
+ * Call after anything other than this renderer has drawn into a buffer it
+ * draws with QURAN_CLEAR_DIRTY (the host, or another renderer sharing the
+ * buffer). The next DIRTY draw into it then clears it fully.
+ *
+ * @param renderer Renderer handle
+ * @param buffer Buffer drawn into elsewhere (NULL = any buffer)
+ */
+void quran_renderer_forget_buffer(QuranRendererHandle renderer, const QuranPixelBuffer* buffer);
+
+/**
+ * Render phase of a two-phase page render
+ */
+typedef enum {
+    QURAN_RENDER_PREVIEW = 0,   // No kashida: lines are justified by stretching spaces only
+    QURAN_RENDER_FINAL = 1,     // Full quality, as quran_renderer_draw_page
+    QURAN_RENDER_DRAFT = 2,     // Preview without anti-aliasing and color layers
+} QuranRenderPhase;
+
+/**
+ * Render a page as a preview or final frame
+ *
+ * Kashida justification is most of the cost of a page. While the page is
+ * moving or changing size (flings, font-size sliders, resize drags) draw
+ * QURAN_RENDER_PREVIEW frames, which skip it and justify by space stretching
+ * only; once the interaction is idle, draw the page again with
+ * QURAN_RENDER_FINAL. Line breaks and heights are the same in both phases,
+ * so the final frame only refines the letter shapes.
+ *
+ * QURAN_RENDER_DRAFT is cheaper still for the first frame of a page nobody
+ * has seen yet: glyph outlines are filled in the text color without
+ * anti-aliasing, COLR layers (surah headers, embedded tajweed colors) or
+ * kashida.
+ *
+ * @param renderer Renderer handle
+ * @param buffer Pixel buffer to render into
+ * @param pageIndex Page index (0-603)
+ * @param config Render configuration
+ * @param phase Phase to render
+ * @return The phase drawn: QURAN_RENDER_FINAL when no final pass is needed
+ *         (also for previews with justify off, which are already final),
+ *         otherwise QURAN_RENDER_PREVIEW or QURAN_RENDER_DRAFT and the host
+ *         should redraw with QURAN_RENDER_FINAL when idle
+ */
+QuranRenderPhase quran_renderer_draw_page_phase(
+    QuranRendererHandle renderer,
+    QuranPixelBuffer* buffer,
+    int pageIndex,
+    const QuranRenderConfig* config,
+    QuranRenderPhase phase
+);
+
+/**
+ * Render a two-page spread (landscape tablets) into one buffer
+ *
+ * rightPage is drawn in the right half and rightPage + 1, its facing page,
+ * in the left half, each exactly as quran_renderer_draw_page draws a page of
+ * that size. A gutter of about 2.5% of the buffer width separates them.
+ * When more than one core is available the two halves render in parallel
+ * (the renderer keeps a second font instance for this). In the printed
+ * mushaf spreads start on even page indices (0 = Al-Fatiha on the right);
+ * for the last page the left half is left blank.
+ *
+ * @param renderer Renderer handle
+ * @param buffer Pixel buffer holding both pages
+ * @param rightPage Page index shown on the right (0-603)
+ * @param config Render configuration
+ */
+void quran_renderer_draw_spread(
+    QuranRendererHandle renderer,
+    QuranPixelBuffer* buffer,
+    int rightPage,
+    const QuranRenderConfig* config
+);
+
+/**
+ * Shape the lines of a page range ahead of drawing
+ *
+ * Shaped lines are cached per justification bucket: kashida justification is
+ * computed for the line width rounded down to 1/8 em and the spaces absorb
+ * the rest, so the many screen widths whose lines differ by a few font units
+ * share one result. Preparing the next pages between frames (or right after
+ * creating the renderer) makes their first draw a cache hit. Call it from the
+ * thread that draws with this renderer.
+ *
+ * The cache holds 16 MB of shaped lines, about 160 pages of one bucket, not
+ * the whole mushaf. A call shapes pages in order and stops once its lines
+ * fill half the cache (about 80 pages per bucket; the common widths of
+ * width 0 fall into a few buckets, each costing as much as one width), so
+ * prepare the pages around the one on screen.
+ *
+ * @param renderer Renderer handle
+ * @param firstPage First page index (0-603)
+ * @param lastPage Last page index, inclusive
+ * @param width Page width in pixels, or 0 for the common phone and tablet
+ *              widths built into the library
+ * @param config Render configuration (tajweed and justify are used)
+ * @return Number of lines shaped (0 when all were cached; pages past the
+ *         budget are left unshaped), or -1 for invalid arguments
+ */
+int quran_renderer_prepare_justification(
+    QuranRendererHandle renderer,
+    int firstPage,
+    int lastPage,
+    int width,
+    const QuranRenderConfig* config
+);
+
 /**
  * Get the total number of pages
  */
 int quran_renderer_get_page_count(QuranRendererHandle renderer);
 
+/* ============================================================================
+ * Asynchronous Rendering
+ * ============================================================================ */
+
+/**
+ * Called when a queued render pass has finished writing the buffer
+ *
+ * Runs on the renderer's background thread. It may post the frame to the UI
+ * thread but must not call quran_renderer_cancel_async or
+ * quran_renderer_wait_async.
+ */
+typedef void (*QuranRenderCallback)(void* userData, int pageIndex, QuranRenderPhase phase);
+
+/**
+ * Queue a page render on the renderer's background thread
+ *
+ * With progressive set, a QURAN_RENDER_DRAFT pass is drawn first so the page
+ * shows up at once, then the QURAN_RENDER_FINAL pass overwrites it; the
+ * callback runs after each. Passes of successive calls run in order. To
+ * follow a fast scroll, cancel the pending passes before queueing the new
+ * page.
+ *
+ * The buffer must stay valid and the renderer must not be used from other
+ * threads until the passes are done or cancelled (quran_renderer_wait_async,
+ * quran_renderer_cancel_async). The config is copied.
+ *
+ * @param renderer Renderer handle
+ * @param buffer Pixel buffer to render into
+ * @param pageIndex Page index (0-603)
+ * @param config Render configuration (NULL for defaults)
+ * @param progressive Draw a draft pass before the final one
+ * @param callback Called after each pass (may be NULL)
+ * @param userData Passed to the callback
+ * @return true if the passes were queued
+ */
+bool quran_renderer_draw_page_async(
+    QuranRendererHandle renderer,
+    const QuranPixelBuffer* buffer,
+    int pageIndex,
+    const QuranRenderConfig* config,
+    bool progressive,
+    QuranRenderCallback callback,
+    void* userData
+);
+
+/**
+ * Drop the queued passes that haven't started and wait for the running one
+ *
+ * Dropped passes don't call their callback.
+ */
+void quran_renderer_cancel_async(QuranRendererHandle renderer);
+
+/**
+ * Wait until all queued passes are done
+ */
+void quran_renderer_wait_async(QuranRendererHandle renderer);
+
+/* ============================================================================
+ * Color Themes
+ * ============================================================================ */
+
+/**
+ * Tajweed color categories
+ */
+typedef enum {
+    QURAN_TAJWEED_GHUNNA = 0,       // Ghunna, idgham, ikhfa and iqlab
+    QURAN_TAJWEED_TAFKHIM = 1,      // Heavy letters
+    QURAN_TAJWEED_SILENT = 2,       // Letters written but not pronounced
+    QURAN_TAJWEED_QALQALA = 3,
+    QURAN_TAJWEED_MADD_NORMAL = 4,  // Madd of 2 counts (lengthening permitted)
+    QURAN_TAJWEED_MADD_SEPARATE = 5, // Madd munfasil
+    QURAN_TAJWEED_MADD_CONNECTED = 6, // Madd muttasil
+    QURAN_TAJWEED_MADD_NECESSARY = 7, // Madd lazim
+    QURAN_TAJWEED_COLOR_COUNT = 8,
+} QuranTajweedColor;
+
+/**
+ * Built-in themes
+ */
+typedef enum {
+    QURAN_THEME_LIGHT = 0,          // Black text on white, the default colors
+    QURAN_THEME_SEPIA = 1,          // Brown text on cream paper
+    QURAN_THEME_NIGHT = 2,          // Light text on black, brightened tajweed colors
+    QURAN_THEME_HIGH_CONTRAST = 3,  // Black text, saturated and well separated tajweed colors
+} QuranThemeStyle;
+
+/**
+ * Colors of the rendered text (0xRRGGBBAA, like QuranRenderConfig.backgroundColor)
+ *
+ * A zero entry keeps the default: automatic black/white text, the tajweed
+ * color of the font (or of the built-in classifier for fonts without one).
+ */
+typedef struct {
+    uint32_t backgroundColor;   // Background the theme is designed for; copy it into QuranRenderConfig
+    uint32_t textColor;         // Text and ayah marker color (0 = by background luminance)
+    uint32_t tajweedColors[QURAN_TAJWEED_COLOR_COUNT];
+} QuranTheme;
+
+/**
+ * Get a built-in theme
+ *
+ * @param style Theme style
+ * @param theme Output theme
+ * @return true on success, false for an unknown style
+ */
+bool quran_renderer_get_builtin_theme(QuranThemeStyle style, QuranTheme* theme);
+
+/**
+ * Set the colors used by every drawing function of the renderer
+ *
+ * The font palette, tajweed colors and the remap of the ayah markers' white
+ * fills to the background are resolved into one lookup table per background
+ * color, so a theme costs nothing per glyph. The background itself still
+ * comes from QuranRenderConfig. Scroll strips and text inputs repaint with
+ * the new colors on their next draw.
+ *
+ * @param renderer Renderer handle
+ * @param theme Theme to use, or NULL for the default colors
+ */
+void quran_renderer_set_theme(QuranRendererHandle renderer, const QuranTheme* theme);
+
+/* ============================================================================
+ * Page Metrics API
+ * ============================================================================ */
+
+/**
+ * Line kind
+ */
+typedef enum {
+    QURAN_LINE_AYAH = 0,        // Ayah text
+    QURAN_LINE_SURAH_NAME = 1,  // Surah name line
+    QURAN_LINE_BISM = 2,        // Basmala line
+} QuranLineKind;
+
+/**
+ * Page layout geometry (device pixels), as used by quran_renderer_draw_page
+ */
+typedef struct {
+    int charHeight;         // Font size
+    int interLine;          // Distance between baselines
+    int yStart;             // Baseline of the first line (includes the Fatiha offset)
+    int xPadding;           // Horizontal margin on each side
+    float scale;            // Device pixels per font unit
+    int lineCount;          // Number of lines on the page
+} QuranPageMetrics;
+
+/**
+ * Line geometry (device pixels)
+ *
+ * The line box spans [left, right] on its baseline; text is right-aligned at
+ * `right` and justified to the full box width. Lines with a special width
+ * (Fatiha, last pages) are centered. For surah name lines drawn with the
+ * surah header font, hasSurahHeader is set and the header rect replaces the
+ * text line.
+ */
+typedef struct {
+    QuranLineKind kind;
+    float baseline;
+    float left;
+    float right;
+    bool hasSurahHeader;
+    int surahNumber;        // Surah of the header, or -1
+    float headerX;
+    float headerY;
+    float headerWidth;
+    float headerHeight;
+} QuranLineMetrics;
+
+/**
+ * Compute the layout of a page without rendering it
+ *
+ * Geometry depends on the buffer size and page only; config is accepted so
+ * metrics stay in sync with quran_renderer_draw_page if layout options are
+ * added, and may be NULL.
+ *
+ * @param renderer Renderer handle
+ * @param pageIndex Page index (0-603)
+ * @param width Buffer width in pixels
+ * @param height Buffer height in pixels
+ * @param config Render configuration (may be NULL)
+ * @param metrics Output page metrics
+ * @param lines Output array for per-line metrics (may be NULL)
+ * @param maxLines Capacity of lines
+ * @return Number of lines on the page (may exceed maxLines), or -1 on error
+ */
+int quran_renderer_get_page_metrics(
+    QuranRendererHandle renderer,
+    int pageIndex,
+    int width,
+    int height,
+    const QuranRenderConfig* config,
+    QuranPageMetrics* metrics,
+    QuranLineMetrics* lines,
+    int maxLines
+);
+
+/* ============================================================================
+ * Text Selection API
+ * ============================================================================ */
+
+/**
+ * Grapheme cluster extents
+ *
+ * One entry per HarfBuzz cluster (a base letter with its marks, or a
+ * ligature), in logical (byte) order. Byte offsets are relative to the
+ * UTF-8 text of the line; x extents are in pixels. Since the text is RTL,
+ * the first cluster is the rightmost.
+ */
+typedef struct {
+    int byteStart;
+    int byteEnd;            // Exclusive
+    float left;
+    float right;
+} QuranCluster;
+
+/**
+ * Get the clusters of a page line as drawn by quran_renderer_draw_page
+ *
+ * x extents are in page buffer coordinates and include justification,
+ * space stretching and the shrink applied to overflowing lines. Byte
+ * offsets match QuranTextSpan/QuranSearchHit. Lines replaced by a surah
+ * header have no clusters.
+ *
+ * @param renderer Renderer handle
+ * @param pageIndex Page index (0-603)
+ * @param lineIndex Line within the page
+ * @param width Buffer width in pixels
+ * @param height Buffer height in pixels
+ * @param config Render configuration used for drawing (NULL = defaults)
+ * @param clusters Output array (may be NULL to query the count)
+ * @param maxClusters Capacity of clusters
+ * @return Number of clusters (may exceed maxClusters), or -1 on error
+ */
+int quran_renderer_get_line_clusters(
+    QuranRendererHandle renderer,
+    int pageIndex,
+    int lineIndex,
+    int width,
+    int height,
+    const QuranRenderConfig* config,
+    QuranCluster* clusters,
+    int maxClusters
+);
+
+/**
+ * Get the clusters of a single line of text
+ *
+ * The text is shaped once, as in quran_renderer_measure_text, and x
+ * extents are relative to the left edge of the text ([0, measured width]).
+ * Use this for selection handles and caret movement instead of measuring
+ * prefixes.
+ *
+ * @param renderer Renderer handle
+ * @param text UTF-8 encoded Arabic text
+ * @param textLength Length in bytes (-1 for null-terminated)
+ * @param fontSize Font size in pixels
+ * @param clusters Output array (may be NULL to query the count)
+ * @param maxClusters Capacity of clusters
+ * @return Number of clusters (may exceed maxClusters), or -1 on error
+ */
+int quran_renderer_get_text_clusters(
+    QuranRendererHandle renderer,
+    const char* text,
+    int textLength,
+    int fontSize,
+    QuranCluster* clusters,
+    int maxClusters
+);
+
 /* ============================================================================
  * Surah/Ayah API
  * ============================================================================ */
@@ -184,6 +601,235 @@ bool quran_renderer_get_page_location(int pageIndex, QuranAyahLocation* location
  */
 int quran_renderer_get_ayah_count(int surahNumber);
 
+/* ============================================================================
+ * Juz/Hizb API
+ * ============================================================================ */
+
+/**
+ * Get the start of a juz (30 parts)
+ *
+ * @param juzNumber Juz number (1-30)
+ * @param location Output structure with the first surah/ayah and its page
+ * @return true on success, false if juzNumber is invalid
+ */
+bool quran_renderer_get_juz_location(int juzNumber, QuranAyahLocation* location);
+
+/**
+ * Get the start of a hizb (60 halves of a juz)
+ *
+ * @param hizbNumber Hizb number (1-60)
+ * @param location Output structure with the first surah/ayah and its page
+ * @return true on success, false if hizbNumber is invalid
+ */
+bool quran_renderer_get_hizb_location(int hizbNumber, QuranAyahLocation* location);
+
+/**
+ * Get the start of a rub al-hizb (240 quarters of a hizb)
+ *
+ * @param rubNumber Rub number (1-240)
+ * @param location Output structure with the first surah/ayah and its page
+ * @return true on success, false if rubNumber is invalid
+ */
+bool quran_renderer_get_rub_location(int rubNumber, QuranAyahLocation* location);
+
+/**
+ * Get the page index where a juz starts
+ *
+ * @param juzNumber Juz number (1-30)
+ * @return Page index (0-603), or -1 if invalid
+ */
+int quran_renderer_get_juz_start_page(int juzNumber);
+
+/**
+ * Get the juz, hizb or rub a page belongs to
+ *
+ * A page belongs to the last division starting on or before it, so a
+ * juz that starts mid-page is already reported on its start page.
+ *
+ * @param pageIndex Page index (0-603)
+ * @return Juz (1-30), hizb (1-60) or rub (1-240) number, or -1 if invalid
+ */
+int quran_renderer_get_page_juz(int pageIndex);
+int quran_renderer_get_page_hizb(int pageIndex);
+int quran_renderer_get_page_rub(int pageIndex);
+
+/* ============================================================================
+ * Ayah Text API
+ * ============================================================================ */
+
+/**
+ * A zero-copy view of part of the Quran text
+ *
+ * text points into the library's static Quran text and stays valid for the
+ * lifetime of the process. It is NOT null-terminated; use length.
+ */
+typedef struct {
+    const char* text;       // UTF-8 text (not null-terminated)
+    int length;             // Length in bytes
+    int pageIndex;          // Page index (0-603)
+    int lineIndex;          // Line within the page (0-14)
+    int byteStart;          // Offset of text within the line text (bytes)
+} QuranTextSpan;
+
+/**
+ * Get the exact text of an ayah as per-line views into the mushaf text
+ *
+ * An ayah returns one span per line it occupies, in reading order, including
+ * lines on the following page when the ayah crosses a page boundary. The
+ * last span ends with the ayah's end marker.
+ *
+ * @param surahNumber Surah number (1-114)
+ * @param ayahNumber Ayah number within surah (1-based)
+ * @param spans Output array (may be NULL to only count spans)
+ * @param maxSpans Capacity of spans
+ * @return Total number of spans (may exceed maxSpans), or -1 if invalid
+ */
+int quran_renderer_get_ayah_spans(
+    int surahNumber,
+    int ayahNumber,
+    QuranTextSpan* spans,
+    int maxSpans
+);
+
+/**
+ * Copy the text of an ayah into a buffer
+ *
+ * Line breaks inside the ayah are replaced by single spaces. The result is
+ * always null-terminated when bufferSize > 0, truncating if needed (like
+ * snprintf).
+ *
+ * @param surahNumber Surah number (1-114)
+ * @param ayahNumber Ayah number within surah (1-based)
+ * @param buffer Output buffer (may be NULL to query the length)
+ * @param bufferSize Size of buffer in bytes
+ * @return Length of the full ayah text in bytes (excluding the terminator),
+ *         or -1 if invalid
+ */
+int quran_renderer_get_ayah_text(
+    int surahNumber,
+    int ayahNumber,
+    char* buffer,
+    int bufferSize
+);
+
+/* ============================================================================
+ * Ayah Image API (share images)
+ * ============================================================================ */
+
+/**
+ * Measure a tightly cropped image of an ayah range
+ *
+ * The ayahs keep their mushaf lines, shaping and justification as on a page
+ * of width pageWidth (which sets the font size, see QuranPageMetrics), with
+ * the lines stacked one line spacing apart even across a page break. The
+ * image covers the ink of the ayahs only (not the rest of their first and
+ * last lines), plus padding on each side.
+ *
+ * @param renderer Renderer handle
+ * @param surahNumber Surah number (1-114)
+ * @param firstAyah First ayah (1-based)
+ * @param lastAyah Last ayah, inclusive (>= firstAyah)
+ * @param pageWidth Width of the virtual page in pixels (sets the scale)
+ * @param padding Margin around the ink in pixels
+ * @param config Render configuration (tajweed, justify; may be NULL)
+ * @param outWidth Output: image width in pixels
+ * @param outHeight Output: image height in pixels
+ * @return true on success, false if the range is invalid
+ */
+bool quran_renderer_measure_ayah_image(
+    QuranRendererHandle renderer,
+    int surahNumber,
+    int firstAyah,
+    int lastAyah,
+    int pageWidth,
+    int padding,
+    const QuranRenderConfig* config,
+    int* outWidth,
+    int* outHeight
+);
+
+/**
+ * Render a tightly cropped image of an ayah range
+ *
+ * Only the lines the ayahs occupy are shaped, and only the glyphs of the
+ * ayahs are rasterized, instead of rendering and cropping a whole page.
+ * Size the buffer with quran_renderer_measure_ayah_image; a larger buffer
+ * gets the image centered.
+ *
+ * @param renderer Renderer handle
+ * @param buffer Pixel buffer (cleared to config->backgroundColor)
+ * @param surahNumber Surah number (1-114)
+ * @param firstAyah First ayah (1-based)
+ * @param lastAyah Last ayah, inclusive (>= firstAyah)
+ * @param pageWidth Width of the virtual page in pixels (sets the scale)
+ * @param padding Margin around the ink in pixels
+ * @param config Render configuration (may be NULL)
+ * @return true on success, false if the range is invalid
+ */
+bool quran_renderer_draw_ayah_image(
+    QuranRendererHandle renderer,
+    QuranPixelBuffer* buffer,
+    int surahNumber,
+    int firstAyah,
+    int lastAyah,
+    int pageWidth,
+    int padding,
+    const QuranRenderConfig* config
+);
+
+/* ============================================================================
+ * Search API
+ * ============================================================================ */
+
+/**
+ * A single search match inside the mushaf text
+ *
+ * Byte offsets are relative to the UTF-8 text of the line (the same line the
+ * page renderer draws). A match that wraps onto the next line is reported on
+ * its first line with byteEnd clamped to the end of that line.
+ */
+typedef struct {
+    int pageIndex;          // Page index (0-603)
+    int lineIndex;          // Line within the page (0-14)
+    int byteStart;          // Start of the match in the line text (bytes)
+    int byteEnd;            // End of the match in the line text (bytes, exclusive)
+    int surahNumber;        // Surah containing the match (1-114)
+    int ayahNumber;         // Ayah containing the match (1-based)
+} QuranSearchHit;
+
+/**
+ * Build the search index ahead of the first query
+ *
+ * The index is otherwise built lazily by the first quran_renderer_search()
+ * call. Call this from a background thread at startup to keep the first
+ * query fast. Safe to call more than once.
+ *
+ * @return true when the index is ready
+ */
+bool quran_renderer_prepare_search_index(void);
+
+/**
+ * Diacritic-insensitive search over the Quran text
+ *
+ * Both the query and the text are normalized before matching: harakat,
+ * Quranic annotation marks and tatweel are ignored, and all alef forms
+ * (أ إ آ ٱ) match a bare alef. Matches may start inside a word, so "رحمن"
+ * finds "ٱلرَّحْمَٰنِ". Hits are returned in mushaf order.
+ *
+ * @param query UTF-8 search text
+ * @param queryLength Length of query in bytes (or -1 for null-terminated)
+ * @param hits Output array (may be NULL to only count matches)
+ * @param maxHits Capacity of hits
+ * @return Total number of matches (may exceed maxHits), or -1 on error.
+ *         The first min(total, maxHits) entries of hits are filled.
+ */
+int quran_renderer_search(
+    const char* query,
+    int queryLength,
+    QuranSearchHit* hits,
+    int maxHits
+);
+
 /* ============================================================================
  * Generic Arabic Text Rendering API
  * ============================================================================ */
@@ -218,6 +864,7 @@ typedef struct {
     bool tajweed;             // Enable tajweed coloring (default: true)
     float marginLeft;         // Left margin in pixels (-1 = auto ~5%, 0 = none)
     float marginRight;        // Right margin in pixels (-1 = auto ~5%, 0 = none)
+    QuranClearMode clearMode; // Background clear before drawing (default: QURAN_CLEAR_FULL)
 } QuranTextConfig;
 
 /**
@@ -233,6 +880,7 @@ typedef struct {
  * - tajweed: true (enabled by default)
  * - marginLeft: -1 (auto ~5%)
  * - marginRight: -1 (auto ~5%)
+ * - clearMode: QURAN_CLEAR_FULL
  */
 static inline QuranTextConfig quran_text_config_default(void) {
     QuranTextConfig config = {0};
@@ -245,6 +893,7 @@ static inline QuranTextConfig quran_text_config_default(void) {
     config.tajweed = true;  // Tajweed coloring enabled by default
     config.marginLeft = QURAN_MARGIN_AUTO;   // Auto margin
     config.marginRight = QURAN_MARGIN_AUTO;  // Auto margin
+    config.clearMode = QURAN_CLEAR_FULL;
     return config;
 }
 
@@ -289,6 +938,73 @@ bool quran_renderer_measure_text(
     int* outHeight
 );
 
+/**
+ * Find the largest font size at which text fits a width
+ *
+ * The text is shaped once at the font's design size. For a single line the
+ * size is solved directly from the advance width (advances scale linearly);
+ * for several lines each word is shaped once and the size is binary searched
+ * by re-wrapping the cached word widths the way
+ * quran_renderer_draw_wrapped_text wraps them, without reshaping.
+ *
+ * @param renderer Renderer handle
+ * @param text UTF-8 encoded Arabic text
+ * @param textLength Length of text in bytes (or -1 for null-terminated)
+ * @param width Available line width in pixels
+ * @param maxLines Maximum number of lines (<= 1 for a single line)
+ * @param minFontSize Smallest acceptable font size in pixels
+ * @param maxFontSize Largest acceptable font size in pixels
+ * @return Largest fitting size in [minFontSize, maxFontSize] (minFontSize
+ *         when even that overflows), or -1 on error
+ */
+int quran_renderer_fit_text_size(
+    QuranRendererHandle renderer,
+    const char* text,
+    int textLength,
+    float width,
+    int maxLines,
+    int minFontSize,
+    int maxFontSize
+);
+
+/**
+ * Ink bounds of a line of text, in pixels
+ *
+ * x is relative to the left edge of the advance box ([0, advance]); y is
+ * relative to the baseline and grows downwards, so top is negative for ink
+ * above the baseline. A buffer of (right - left) x (bottom - top) pixels
+ * with the baseline at -top holds every mark.
+ */
+typedef struct {
+    float advance;          // Sum of advances (the width measure_text reports)
+    float left;
+    float top;
+    float right;
+    float bottom;
+} QuranTextBounds;
+
+/**
+ * Measure the ink bounds of Arabic text without rendering
+ *
+ * Unlike quran_renderer_measure_text, whose height is just fontSize, the
+ * bounds cover the actual glyph outlines including marks above and below.
+ * Glyph extents are cached per glyph and kashida variation instance.
+ *
+ * @param renderer Renderer handle
+ * @param text UTF-8 encoded Arabic text
+ * @param textLength Length of text in bytes (or -1 for null-terminated)
+ * @param fontSize Font size in pixels
+ * @param bounds Output bounds (all zero for empty text)
+ * @return true on success
+ */
+bool quran_renderer_measure_text_bounds(
+    QuranRendererHandle renderer,
+    const char* text,
+    int textLength,
+    int fontSize,
+    QuranTextBounds* bounds
+);
+
 /**
  * Render multi-line Arabic text with automatic line breaking
  * 
@@ -332,6 +1048,285 @@ int quran_renderer_draw_wrapped_text(
     float lineSpacing
 );
 
+/* ============================================================================
+ * Text Document API (long scrollable text)
+ * ============================================================================ */
+
+/**
+ * Opaque text document handle
+ *
+ * A document holds long Arabic text (tafsir, translation) laid out for a
+ * given width. Words are shaped once and cached; lines are broken lazily,
+ * only as far as a draw call needs, and a width change reflows from the
+ * cached word widths without reshaping. Drawing renders only the lines
+ * that intersect the viewport: lines that are not justified are painted
+ * from per-word shaped runs, justified lines are shaped as a whole.
+ *
+ * A document must not outlive its renderer and is not thread-safe.
+ */
+typedef struct QuranTextDocumentImpl* QuranTextDocumentHandle;
+
+/**
+ * Create a text document
+ *
+ * Layout follows quran_renderer_draw_wrapped_text: config->fontSize (0 = 48),
+ * margins (-1 = auto ~5% of width), config->lineWidth (0 = width minus
+ * margins) and lineSpacing (0 = 1.5). Paragraphs are separated by '\n';
+ * with config->justify, every line but the last of a paragraph is justified.
+ *
+ * @param renderer Renderer handle
+ * @param text UTF-8 encoded Arabic text (copied)
+ * @param textLength Length in bytes (-1 for null-terminated)
+ * @param config Text rendering configuration (may be NULL)
+ * @param lineSpacing Line spacing multiplier
+ * @param width Viewport width in pixels
+ * @return Document handle, or NULL on error
+ */
+QuranTextDocumentHandle quran_text_document_create(
+    QuranRendererHandle renderer,
+    const char* text,
+    int textLength,
+    const QuranTextConfig* config,
+    float lineSpacing,
+    int width
+);
+
+/**
+ * Create a reflowable document from a range of the mushaf text
+ *
+ * Renders ayahs as flowing text at any width instead of the fixed 15-line
+ * page, for small screens and large accessibility font sizes. The text is
+ * taken from the page text; each surah starts a new paragraph, preceded by
+ * its name and basmala lines. With config->justify, lines are stretched with
+ * kashida like the mushaf pages, except the last line of each paragraph.
+ *
+ * @param renderer Renderer handle
+ * @param startSurah First surah (1-114)
+ * @param startAyah First ayah within startSurah (1-based)
+ * @param endSurah Last surah (1-114)
+ * @param endAyah Last ayah within endSurah (1-based, inclusive)
+ * @param config Text rendering configuration (may be NULL)
+ * @param lineSpacing Line spacing multiplier
+ * @param width Viewport width in pixels
+ * @return Document handle, or NULL if the range is invalid
+ */
+QuranTextDocumentHandle quran_text_document_create_ayahs(
+    QuranRendererHandle renderer,
+    int startSurah,
+    int startAyah,
+    int endSurah,
+    int endAyah,
+    const QuranTextConfig* config,
+    float lineSpacing,
+    int width
+);
+
+/**
+ * Destroy a text document
+ */
+void quran_text_document_destroy(QuranTextDocumentHandle document);
+
+/**
+ * Change the viewport width; lines are rebroken lazily from cached word widths
+ */
+void quran_text_document_set_width(QuranTextDocumentHandle document, int width);
+
+/**
+ * Change the font size in pixels
+ *
+ * Words are shaped in font units, so a new size only rebreaks lines from
+ * the cached word widths; word runs already shaped are reused. Meant to be
+ * called on every step of a font size slider.
+ */
+void quran_text_document_set_font_size(QuranTextDocumentHandle document, int fontSize);
+
+/**
+ * Get the total content height in pixels (lays out the whole document)
+ */
+int quran_text_document_get_height(QuranTextDocumentHandle document);
+
+/**
+ * Get the number of lines (lays out the whole document)
+ */
+int quran_text_document_get_line_count(QuranTextDocumentHandle document);
+
+/**
+ * Render the lines visible in a viewport
+ *
+ * The buffer is the viewport: its top row is content y = scrollY. Its width
+ * should match the document width.
+ *
+ * @param document Document handle
+ * @param buffer Viewport pixel buffer (cleared to the background color)
+ * @param scrollY Content y of the viewport top, in pixels
+ * @return Number of lines drawn, or -1 on error
+ */
+int quran_text_document_draw(
+    QuranTextDocumentHandle document,
+    QuranPixelBuffer* buffer,
+    int scrollY
+);
+
+/* ============================================================================
+ * Text Input API (incremental rendering while typing)
+ * ============================================================================ */
+
+/**
+ * A rectangle in buffer pixels
+ */
+typedef struct {
+    int x;
+    int y;
+    int width;
+    int height;
+} QuranRect;
+
+/**
+ * Opaque text input handle
+ *
+ * Renders a single line of text that changes a keystroke at a time (note
+ * fields, search-as-you-type), laid out like quran_renderer_draw_text.
+ * Arabic joining never crosses a space, so each word is shaped on its own:
+ * an update reshapes only from the last word boundary before the first
+ * changed byte and repaints only the part of the buffer those words (old
+ * and new) cover. Justification is not applied.
+ *
+ * An input must not outlive its renderer and is not thread-safe.
+ */
+typedef struct QuranTextInputImpl* QuranTextInputHandle;
+
+/**
+ * Create a text input
+ *
+ * @param renderer Renderer handle
+ * @param config Text rendering configuration (copied, may be NULL)
+ * @return Input handle, or NULL on error
+ */
+QuranTextInputHandle quran_text_input_create(
+    QuranRendererHandle renderer,
+    const QuranTextConfig* config
+);
+
+/**
+ * Destroy a text input
+ */
+void quran_text_input_destroy(QuranTextInputHandle input);
+
+/**
+ * Force the next update to repaint the whole buffer (e.g. after the host
+ * cleared or reused it)
+ */
+void quran_text_input_invalidate(QuranTextInputHandle input);
+
+/**
+ * Set the current text and bring the buffer up to date
+ *
+ * The buffer must keep the previous contents between calls. The first
+ * update, or one with a different buffer, repaints it entirely.
+ *
+ * @param input Input handle
+ * @param buffer Pixel buffer holding the previously rendered text
+ * @param text UTF-8 encoded text
+ * @param textLength Length of text in bytes (or -1 for null-terminated)
+ * @param dirty Output: region that was repainted (width 0 if none; may be NULL)
+ * @return Width of the text in pixels, or -1 on error
+ */
+int quran_text_input_update(
+    QuranTextInputHandle input,
+    QuranPixelBuffer* buffer,
+    const char* text,
+    int textLength,
+    QuranRect* dirty
+);
+
+/* ============================================================================
+ * Scroll Strip API (continuous vertical reading mode)
+ * ============================================================================ */
+
+/**
+ * Opaque scroll strip handle
+ *
+ * A strip lays the 604 pages out as one continuous column of lines at a
+ * given width, so a vertical reading mode renders only the lines in view
+ * instead of whole pages stitched together. Line slots come from a
+ * line-height index (strip y of every line), and rendered lines are kept
+ * in a byte-budgeted cache, so scrolling mostly composites cached lines.
+ *
+ * Lines are laid out as on a page of the same width: same font size, line
+ * widths, justification and surah headers, with the page line spacing for
+ * a page too short to add extra space. Pages are separated by pageGap
+ * pixels of background.
+ *
+ * A strip must not outlive its renderer and is not thread-safe.
+ */
+typedef struct QuranScrollStripImpl* QuranScrollStripHandle;
+
+/**
+ * Create a scroll strip
+ *
+ * @param renderer Renderer handle
+ * @param config Render configuration (tajweed, justify, backgroundColor,
+ *               useForeground; may be NULL for the draw_page defaults)
+ * @param width Strip width in pixels
+ * @param pageGap Space between pages in pixels (0 = continuous)
+ * @return Strip handle, or NULL on error
+ */
+QuranScrollStripHandle quran_scroll_strip_create(
+    QuranRendererHandle renderer,
+    const QuranRenderConfig* config,
+    int width,
+    int pageGap
+);
+
+/**
+ * Destroy a scroll strip
+ */
+void quran_scroll_strip_destroy(QuranScrollStripHandle strip);
+
+/**
+ * Change the strip width (rebuilds the line index and drops cached lines)
+ */
+void quran_scroll_strip_set_width(QuranScrollStripHandle strip, int width);
+
+/**
+ * Get the total strip height in pixels
+ */
+int quran_scroll_strip_get_height(QuranScrollStripHandle strip);
+
+/**
+ * Get the height of one line slot in pixels
+ */
+int quran_scroll_strip_get_line_height(QuranScrollStripHandle strip);
+
+/**
+ * Get the strip y of a page's first line, or -1 if invalid
+ */
+int quran_scroll_strip_get_page_top(QuranScrollStripHandle strip, int pageIndex);
+
+/**
+ * Get the page shown at strip y (a page gap belongs to the page before it),
+ * or -1 outside the strip
+ */
+int quran_scroll_strip_get_page_at(QuranScrollStripHandle strip, int y);
+
+/**
+ * Render the strip window [y0, y0 + buffer->height)
+ *
+ * The buffer's top row is strip y = y0; its width should match the strip
+ * width. Lines crossing the window edges are drawn partially, including
+ * marks that extend into a neighbouring line's slot.
+ *
+ * @param strip Strip handle
+ * @param buffer Window pixel buffer (cleared to the background color)
+ * @param y0 Strip y of the window top, in pixels
+ * @return Number of lines drawn, or -1 on error
+ */
+int quran_scroll_strip_draw(
+    QuranScrollStripHandle strip,
+    QuranPixelBuffer* buffer,
+    int y0
+);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,180 @@
+#!/usr/bin/env python3
+#
+# generate-metadata.py
+#
+# Regenerate src/core/quran_metadata.h from the JSON sources in src/core:
+#   quranmetadata.json  - surah names, ayah counts, revelation order
+#   pages.json          - first surah/ayah of each of the 604 pages
+#   quarters.json       - first surah/ayah of each of the 240 hizb quarters
+#
+# Usage:
+#   ./scripts/generate-metadata.py [--check]
+#
+# Options:
+#   --check   Exit with status 1 if the header is out of date (no write)
+#
+
+import json
+import os
+import sys
+
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+CORE_DIR = os.path.join(os.path.dirname(SCRIPT_DIR), "src", "core")
+HEADER_PATH = os.path.join(CORE_DIR, "quran_metadata.h")
+
+PAGE_COUNT = 604
+QUARTER_COUNT = 240
+QUARTERS_PER_HIZB = 4
+QUARTERS_PER_JUZ = 8
+
+
+def load(name):
+    with open(os.path.join(CORE_DIR, name), encoding="utf-8") as f:
+        return json.load(f)
+
+
+def page_of(locations, sura, aya):
+    # Last page whose first ayah is at or before (sura, aya)
+    page = 0
+    for index, location in enumerate(locations):
+        if location <= (sura, aya):
+            page = index
+    return page
+
+
+def generate():
+    surahs = load("quranmetadata.json")
+    pages = load("pages.json")
+    quarters = load("quarters.json")
+
+    page_locations = [(pages[str(i)]["sura"], pages[str(i)]["aya"]) for i in range(1, PAGE_COUNT + 1)]
+    quarter_locations = [(quarters[str(i)]["sura"], quarters[str(i)]["aya"]) for i in range(1, QUARTER_COUNT + 1)]
+
+    if len(surahs) != 114 or len(page_locations) != PAGE_COUNT or len(quarter_locations) != QUARTER_COUNT:
+        raise SystemExit("Unexpected number of entries in the JSON sources")
+    if quarter_locations != sorted(quarter_locations):
+        raise SystemExit("quarters.json is not in mushaf order")
+
+    out = []
+    out.append("/**")
+    out.append(" * Quran Metadata - Surah and Page information")
+    out.append(" * Auto-generated from quranmetadata.json, pages.json and quarters.json")
+    out.append(" * by scripts/generate-metadata.py - do not edit by hand")
+    out.append(" */")
+    out.append("")
+    out.append("#ifndef QURAN_METADATA_H")
+    out.append("#define QURAN_METADATA_H")
+    out.append("")
+    out.append("#include <cstdint>")
+    out.append("")
+    out.append("struct SurahData {")
+    out.append("    int number;")
+    out.append("    int ayahCount;")
+    out.append("    int startAyah;          // Cumulative starting ayah (0-based)")
+    out.append("    const char* nameArabic;")
+    out.append("    const char* nameTrans;")
+    out.append("    const char* nameEnglish;")
+    out.append("    const char* type;")
+    out.append("    int revelationOrder;")
+    out.append("    int rukuCount;")
+    out.append("};")
+    out.append("")
+    out.append("// Total counts")
+    out.append("static constexpr int QURAN_SURAH_COUNT = 114;")
+    out.append("static constexpr int QURAN_TOTAL_AYAHS = 6236;")
+    out.append("static constexpr int QURAN_PAGE_COUNT = 604;")
+    out.append("")
+    out.append("// Surah metadata (1-indexed, index 0 is unused)")
+    out.append("static const SurahData SURAH_DATA[115] = {")
+    out.append("    // Index 0 - unused placeholder")
+    out.append('    {0, 0, 0, "", "", "", "", 0, 0},')
+    for number in range(1, 115):
+        s = surahs[str(number)]
+        out.append("    // %d. %s" % (number, s["tname"]))
+        out.append('    {%d, %d, %d, "%s", "%s", "%s", "%s", %d, %d},' % (
+            number, s["ayas"], s["start"], s["name"], s["tname"], s["ename"],
+            s["type"], s["order"], s["rukus"]))
+    out.append("};")
+    out.append("")
+    out.append("// Page to Surah/Ayah mapping (which surah/ayah starts each page)")
+    out.append("struct PageLocation {")
+    out.append("    int surahNumber;")
+    out.append("    int ayahNumber;")
+    out.append("};")
+    out.append("")
+    out.append("// Page start locations - first surah/ayah on each page (0-indexed page array)")
+    out.append("// Derived from standard Madina Mushaf layout (1-indexed pages in original data)")
+    out.append("static const PageLocation PAGE_LOCATIONS[604] = {")
+    for index, (sura, aya) in enumerate(page_locations):
+        out.append("    {%d, %d},   // Page %d" % (sura, aya, index))
+    out.append("};")
+    out.append("")
+
+    # Juz / hizb / rub al-hizb navigation tables (from quarters.json)
+    quarter_pages = [page_of(page_locations, sura, aya) for sura, aya in quarter_locations]
+
+    out.append("// Juz / hizb / rub al-hizb counts")
+    out.append("static constexpr int QURAN_JUZ_COUNT = 30;")
+    out.append("static constexpr int QURAN_HIZB_COUNT = 60;")
+    out.append("static constexpr int QURAN_RUB_COUNT = 240;")
+    out.append("")
+    out.append("// Rub al-hizb (hizb quarter) start location and the page it starts on")
+    out.append("struct RubLocation {")
+    out.append("    int surahNumber;")
+    out.append("    int ayahNumber;")
+    out.append("    int pageIndex;")
+    out.append("};")
+    out.append("")
+    out.append("// Rub start locations (0-indexed rub array)")
+    out.append("// Rub r starts hizb r/4+1 when r%4 == 0 and juz r/8+1 when r%8 == 0")
+    out.append("static const RubLocation RUB_LOCATIONS[240] = {")
+    for index, ((sura, aya), page) in enumerate(zip(quarter_locations, quarter_pages)):
+        out.append("    {%d, %d, %d},   // Rub %d (Juz %d, Hizb %d)" % (
+            sura, aya, page, index + 1, index // QUARTERS_PER_JUZ + 1, index // QUARTERS_PER_HIZB + 1))
+    out.append("};")
+    out.append("")
+
+    # Last rub starting on or before each page, so that a page where a juz
+    # starts mid-page already reports the new juz (inverse of RUB_LOCATIONS)
+    page_rubs = []
+    for page in range(PAGE_COUNT):
+        rub = 0
+        for index, quarter_page in enumerate(quarter_pages):
+            if quarter_page <= page:
+                rub = index
+        page_rubs.append(rub)
+
+    out.append("// Last rub (0-indexed) starting on or before each page (0-indexed page array)")
+    out.append("// Juz = rub/8+1, hizb = rub/4+1")
+    out.append("static const uint8_t PAGE_RUBS[604] = {")
+    for row in range(0, PAGE_COUNT, 16):
+        values = ", ".join("%d" % rub for rub in page_rubs[row:row + 16])
+        out.append("    %s,   // Pages %d-%d" % (values, row, min(row + 15, PAGE_COUNT - 1)))
+    out.append("};")
+    out.append("")
+    out.append("#endif // QURAN_METADATA_H")
+    return "\n".join(out) + "\n"
+
+
+def main():
+    check = "--check" in sys.argv[1:]
+    header = generate()
+
+    with open(HEADER_PATH, encoding="utf-8") as f:
+        current = f.read()
+
+    if check:
+        if current != header:
+            print("quran_metadata.h is out of date; run scripts/generate-metadata.py")
+            return 1
+        return 0
+
+    if current != header:
+        with open(HEADER_PATH, "w", encoding="utf-8") as f:
+            f.write(header)
+        print("Updated %s" % HEADER_PATH)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
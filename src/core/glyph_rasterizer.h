@@ -0,0 +1,183 @@
+/**
+ * Glyph rasterizer - signed-area coverage for small filled outlines
+ *
+ * Each line segment adds the area it covers, signed by its direction, to the
+ * cells of an accumulation buffer (as in font-rs and stb_truetype v2). A
+ * running sum along each row then gives the winding-weighted coverage of
+ * every pixel, clamped to [0, 1] for nonzero fill. Glyph outlines are small,
+ * closed and already flattened to lines, so this skips the edge lists and
+ * sorting of a general path filler. The row sums use SSE2 or NEON.
+ */
+
+#ifndef QURAN_RENDERER_GLYPH_RASTERIZER_H
+#define QURAN_RENDERER_GLYPH_RASTERIZER_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define QURAN_RASTERIZER_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define QURAN_RASTERIZER_NEON 1
+#endif
+
+class GlyphRasterizer {
+public:
+    // Clears a width x height area
+    void reset(int width, int height) {
+        w = std::max(0, width);
+        h = std::max(0, height);
+        // Segments at the right edge write two cells past it; rows are padded
+        // to whole vectors
+        rowStride = (static_cast<size_t>(w) + 2 + 3) & ~static_cast<size_t>(3);
+        cells.assign(rowStride * h, 0.0f);
+    }
+
+    int width() const { return w; }
+    int height() const { return h; }
+
+    // Adds a line segment in area pixels, y down. Points outside the area
+    // are clamped horizontally and clipped vertically.
+    void line(float x0, float y0, float x1, float y1) {
+        if (y0 == y1) return;
+
+        float direction = 1.0f;
+        if (y0 > y1) {
+            std::swap(x0, x1);
+            std::swap(y0, y1);
+            direction = -1.0f;
+        }
+
+        const float top = std::max(y0, 0.0f);
+        const float bottom = std::min(y1, static_cast<float>(h));
+        if (top >= bottom) return;
+
+        const float dxdy = (x1 - x0) / (y1 - y0);
+        const float maxX = static_cast<float>(w);
+        float x = x0 + (top - y0) * dxdy;
+
+        for (int y = static_cast<int>(top); y < h && static_cast<float>(y) < bottom; y++) {
+            float* row = &cells[static_cast<size_t>(y) * rowStride];
+            const float dy = std::min(static_cast<float>(y + 1), bottom) - std::max(static_cast<float>(y), top);
+            const float xNext = x + dxdy * dy;
+            const float d = dy * direction;
+
+            const float xa = std::min(std::max(std::min(x, xNext), 0.0f), maxX);
+            const float xb = std::min(std::max(std::max(x, xNext), 0.0f), maxX);
+            const float xaFloor = std::floor(xa);
+            const int xai = static_cast<int>(xaFloor);
+            const float xbCeil = std::ceil(xb);
+            const int xbi = static_cast<int>(xbCeil);
+
+            if (xbi <= xai + 1) {
+                // Within one cell: split by the mean x
+                const float xm = 0.5f * (xa + xb) - xaFloor;
+                row[xai] += d - d * xm;
+                row[xai + 1] += d * xm;
+            } else {
+                // Across cells: triangle at each end, constant slope between
+                const float s = 1.0f / (xb - xa);
+                const float xaf = xa - xaFloor;
+                const float a0 = 0.5f * s * (1.0f - xaf) * (1.0f - xaf);
+                const float xbf = xb - xbCeil + 1.0f;
+                const float am = 0.5f * s * xbf * xbf;
+
+                row[xai] += d * a0;
+                if (xbi == xai + 2) {
+                    row[xai + 1] += d * (1.0f - a0 - am);
+                } else {
+                    const float a1 = s * (1.5f - xaf);
+                    row[xai + 1] += d * (a1 - a0);
+                    for (int xi = xai + 2; xi < xbi - 1; xi++) {
+                        row[xi] += d * s;
+                    }
+                    const float a2 = a1 + static_cast<float>(xbi - xai - 3) * s;
+                    row[xbi - 1] += d * (1.0f - a2 - am);
+                }
+                row[xbi] += d * am;
+            }
+
+            x = xNext;
+        }
+    }
+
+    // Writes 8-bit nonzero coverage, one byte per pixel, rows stride bytes apart
+    void coverage(uint8_t* out, size_t stride) const {
+        for (int y = 0; y < h; y++) {
+            accumulateRow(&cells[static_cast<size_t>(y) * rowStride], out + static_cast<size_t>(y) * stride);
+        }
+    }
+
+private:
+    static inline uint8_t toCoverage(float sum) {
+        return static_cast<uint8_t>(std::min(std::fabs(sum), 1.0f) * 255.0f + 0.5f);
+    }
+
+    // Prefix sum of one row's cells, four at a time
+    void accumulateRow(const float* row, uint8_t* out) const {
+        int x = 0;
+        float sum = 0.0f;
+
+#if defined(QURAN_RASTERIZER_SSE2)
+        const __m128 signMask = _mm_set1_ps(-0.0f);
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 scale = _mm_set1_ps(255.0f);
+        const __m128 half = _mm_set1_ps(0.5f);
+        __m128 offset = _mm_setzero_ps();
+        for (; x + 4 <= w; x += 4) {
+            __m128 v = _mm_loadu_ps(row + x);
+            v = _mm_add_ps(v, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(v), 4)));
+            v = _mm_add_ps(v, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(v), 8)));
+            v = _mm_add_ps(v, offset);
+            offset = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3));
+
+            __m128 a = _mm_min_ps(_mm_andnot_ps(signMask, v), one);
+            __m128i n = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(a, scale), half));
+            n = _mm_packs_epi32(n, n);
+            n = _mm_packus_epi16(n, n);
+            const int32_t packed = _mm_cvtsi128_si32(n);
+            std::memcpy(out + x, &packed, 4);
+        }
+        sum = _mm_cvtss_f32(offset);
+#elif defined(QURAN_RASTERIZER_NEON)
+        const float32x4_t zero = vdupq_n_f32(0.0f);
+        const float32x4_t one = vdupq_n_f32(1.0f);
+        const float32x4_t scale = vdupq_n_f32(255.0f);
+        const float32x4_t half = vdupq_n_f32(0.5f);
+        float32x4_t offset = zero;
+        for (; x + 4 <= w; x += 4) {
+            float32x4_t v = vld1q_f32(row + x);
+            v = vaddq_f32(v, vextq_f32(zero, v, 3));
+            v = vaddq_f32(v, vextq_f32(zero, v, 2));
+            v = vaddq_f32(v, offset);
+            offset = vdupq_n_f32(vgetq_lane_f32(v, 3));
+
+            float32x4_t a = vminq_f32(vabsq_f32(v), one);
+            uint32x4_t n = vcvtq_u32_f32(vmlaq_f32(half, a, scale));
+            uint16x4_t n16 = vmovn_u32(n);
+            uint8x8_t n8 = vmovn_u16(vcombine_u16(n16, n16));
+            const uint32_t packed = vget_lane_u32(vreinterpret_u32_u8(n8), 0);
+            std::memcpy(out + x, &packed, 4);
+        }
+        sum = vgetq_lane_f32(offset, 0);
+#endif
+
+        for (; x < w; x++) {
+            sum += row[x];
+            out[x] = toCoverage(sum);
+        }
+    }
+
+    int w = 0;
+    int h = 0;
+    size_t rowStride = 0;
+    std::vector<float> cells;
+};
+
+#endif // QURAN_RENDERER_GLYPH_RASTERIZER_H
@@ -0,0 +1,158 @@
+/**
+ * Glyph SDF - signed distance fields of glyph outlines for scale-free fills
+ */
+
+#include "glyph_sdf.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "glyph_rasterizer.h"
+#include "hb_skia_canvas.h"
+
+namespace {
+
+inline float segmentDistanceSquared(float px, float py, const float* segment) {
+    const float ax = segment[0], ay = segment[1];
+    const float dx = segment[2] - ax, dy = segment[3] - ay;
+    const float length2 = dx * dx + dy * dy;
+    float t = length2 > 0 ? ((px - ax) * dx + (py - ay) * dy) / length2 : 0.0f;
+    t = std::min(std::max(t, 0.0f), 1.0f);
+    const float ex = ax + t * dx - px, ey = ay + t * dy - py;
+    return ex * ex + ey * ey;
+}
+
+// Texel value, or "far outside" past the edge of the field
+inline int texel(const GlyphSdf& sdf, int x, int y) {
+    if (x < 0 || y < 0 || x >= sdf.width || y >= sdf.height) return 0;
+    return sdf.distance[static_cast<size_t>(y) * sdf.width + x];
+}
+
+} // namespace
+
+std::shared_ptr<const GlyphSdf> quranBuildGlyphSdf(hb_font_t* font, hb_codepoint_t glyph) {
+    hb_glyph_extents_t extents;
+    if (!hb_font_get_glyph_extents(font, glyph, &extents) || extents.width == 0 || extents.height == 0) {
+        return nullptr;
+    }
+
+    int xScale, yScale;
+    hb_font_get_scale(font, &xScale, &yScale);
+
+    auto sdf = std::make_shared<GlyphSdf>();
+    const float unit = static_cast<float>(std::abs(xScale)) / kSdfTexelsPerEm;
+    const float left = static_cast<float>(std::min(extents.x_bearing, extents.x_bearing + extents.width));
+    const float right = static_cast<float>(std::max(extents.x_bearing, extents.x_bearing + extents.width));
+    const float top = static_cast<float>(std::max(extents.y_bearing, extents.y_bearing + extents.height));
+    const float bottom = static_cast<float>(std::min(extents.y_bearing, extents.y_bearing + extents.height));
+
+    sdf->unitsPerTexel = unit;
+    sdf->originX = left - kSdfSpread * unit;
+    sdf->originY = top + kSdfSpread * unit;
+    sdf->width = static_cast<int>(std::ceil((right - left) / unit)) + 2 * kSdfSpread;
+    sdf->height = static_cast<int>(std::ceil((top - bottom) / unit)) + 2 * kSdfSpread;
+
+    // Outline in texel space, y down
+    SkMatrix matrix = SkMatrix::Translate(-sdf->originX / unit, sdf->originY / unit);
+    matrix.preScale(1.0f / unit, -1.0f / unit);
+    std::vector<float> segments;
+    hb_skia_glyph_segments(font, glyph, matrix, 0.05f * unit, &segments);
+    if (segments.empty()) return nullptr;
+
+    const int width = sdf->width;
+    const int height = sdf->height;
+
+    // Inside or outside: nonzero coverage of the texel
+    GlyphRasterizer rasterizer;
+    rasterizer.reset(width, height);
+    for (size_t i = 0; i + 3 < segments.size(); i += 4) {
+        rasterizer.line(segments[i], segments[i + 1], segments[i + 2], segments[i + 3]);
+    }
+    std::vector<uint8_t> inside(static_cast<size_t>(width) * height);
+    rasterizer.coverage(inside.data(), width);
+
+    // Distance to the outline: each segment only reaches the texels within
+    // the spread of it, so the cost follows the outline length, not the area
+    const float maxDistance2 = static_cast<float>(kSdfSpread * kSdfSpread);
+    std::vector<float> distance2(static_cast<size_t>(width) * height, maxDistance2);
+    for (size_t i = 0; i + 3 < segments.size(); i += 4) {
+        const float* segment = &segments[i];
+        const int x0 = std::max(0, static_cast<int>(std::floor(std::min(segment[0], segment[2]))) - kSdfSpread);
+        const int x1 = std::min(width - 1, static_cast<int>(std::ceil(std::max(segment[0], segment[2]))) + kSdfSpread);
+        const int y0 = std::max(0, static_cast<int>(std::floor(std::min(segment[1], segment[3]))) - kSdfSpread);
+        const int y1 = std::min(height - 1, static_cast<int>(std::ceil(std::max(segment[1], segment[3]))) + kSdfSpread);
+        for (int y = y0; y <= y1; y++) {
+            float* row = &distance2[static_cast<size_t>(y) * width];
+            for (int x = x0; x <= x1; x++) {
+                row[x] = std::min(row[x], segmentDistanceSquared(x + 0.5f, y + 0.5f, segment));
+            }
+        }
+    }
+
+    sdf->distance.resize(distance2.size());
+    const float toByte = 127.0f / kSdfSpread;
+    for (size_t i = 0; i < distance2.size(); i++) {
+        float d = std::sqrt(distance2[i]);
+        if (inside[i] < 128) d = -d;
+        sdf->distance[i] = static_cast<uint8_t>(std::min(std::max(128.0f + d * toByte + 0.5f, 0.0f), 255.0f));
+    }
+
+    return sdf;
+}
+
+bool quranSampleGlyphSdf(const GlyphSdf& sdf, const SkMatrix& matrix, const SkIRect& clip,
+                         std::vector<uint8_t>* mask, SkIRect* bounds) {
+    const float sx = matrix.getScaleX(), sy = matrix.getScaleY();
+    const float tx = matrix.getTranslateX(), ty = matrix.getTranslateY();
+    const float unit = sdf.unitsPerTexel;
+    if (sx == 0 || sy == 0 || unit <= 0) return false;
+
+    // Device rectangle of the field
+    const float ax = sx * sdf.originX + tx;
+    const float bx = sx * (sdf.originX + sdf.width * unit) + tx;
+    const float ay = sy * sdf.originY + ty;
+    const float by = sy * (sdf.originY - sdf.height * unit) + ty;
+    SkIRect area = SkIRect::MakeLTRB(static_cast<int>(std::floor(std::min(ax, bx))),
+                                     static_cast<int>(std::floor(std::min(ay, by))),
+                                     static_cast<int>(std::ceil(std::max(ax, bx))),
+                                     static_cast<int>(std::ceil(std::max(ay, by))));
+    if (!area.intersect(clip)) return false;
+    *bounds = area;
+
+    const int width = area.width();
+    const int height = area.height();
+    mask->assign(static_cast<size_t>(width) * height, 0);
+
+    // Pixel centers to texel coordinates (texel centers at +0.5)
+    const float uStep = 1.0f / (sx * unit);
+    const float vStep = -1.0f / (sy * unit);
+    const float u0 = ((area.left() + 0.5f - tx) / sx - sdf.originX) / unit - 0.5f;
+    const float v0 = (sdf.originY - (area.top() + 0.5f - ty) / sy) / unit - 0.5f;
+
+    // A byte step is spread/127 texels; coverage is the distance in pixels
+    // from the pixel center, centered on the outline
+    const float pixelsPerTexel = std::abs(sx) * unit;
+    const float coverageScale = pixelsPerTexel * kSdfSpread / 127.0f;
+
+    for (int y = 0; y < height; y++) {
+        const float v = v0 + y * vStep;
+        const int ty0 = static_cast<int>(std::floor(v));
+        const float fy = v - ty0;
+        uint8_t* out = mask->data() + static_cast<size_t>(y) * width;
+
+        for (int x = 0; x < width; x++) {
+            const float u = u0 + x * uStep;
+            const int tx0 = static_cast<int>(std::floor(u));
+            const float fx = u - tx0;
+
+            const float top = texel(sdf, tx0, ty0) * (1 - fx) + texel(sdf, tx0 + 1, ty0) * fx;
+            const float bottom = texel(sdf, tx0, ty0 + 1) * (1 - fx) + texel(sdf, tx0 + 1, ty0 + 1) * fx;
+            const float value = top * (1 - fy) + bottom * fy;
+
+            const float coverage = 0.5f + (value - 128.0f) * coverageScale;
+            out[x] = static_cast<uint8_t>(std::min(std::max(coverage, 0.0f), 1.0f) * 255.0f + 0.5f);
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,48 @@
+/**
+ * Glyph SDF - signed distance fields of glyph outlines for scale-free fills
+ *
+ * A glyph instance (glyph and kashida variation) is turned once into a small
+ * grid of distances to its outline, sampled at a fixed resolution per em.
+ * Filling it at any later scale costs one bilinear lookup per covered pixel,
+ * however many curves the outline has, so zoom frames skip the outline
+ * entirely. Edges stay sharp when magnified because the distance, not the
+ * coverage, is interpolated.
+ */
+
+#ifndef QURAN_RENDERER_GLYPH_SDF_H
+#define QURAN_RENDERER_GLYPH_SDF_H
+
+#include <hb.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "SkCanvas.h"
+#include "SkMatrix.h"
+
+struct GlyphSdf {
+    int width = 0;              // Texels
+    int height = 0;
+    float originX = 0;          // Font units of the top-left texel corner (y up)
+    float originY = 0;
+    float unitsPerTexel = 0;
+    std::vector<uint8_t> distance; // 128 = on the outline, larger inside; kSdfSpread texels full range
+
+    size_t bytes() const { return sizeof(GlyphSdf) + distance.size(); }
+};
+
+// Texels per em of every field and the distance (texels) a byte can express
+constexpr int kSdfTexelsPerEm = 64;
+constexpr int kSdfSpread = 4;
+
+// Builds the field of a glyph at the font's current variation coordinates.
+// Returns nullptr for glyphs without an outline.
+std::shared_ptr<const GlyphSdf> quranBuildGlyphSdf(hb_font_t* font, hb_codepoint_t glyph);
+
+// Samples a field drawn through matrix (font units to device pixels; scale
+// and translation only) into an A8 coverage mask over its device bounds
+// within clip. Returns false when nothing falls inside the clip.
+bool quranSampleGlyphSdf(const GlyphSdf& sdf, const SkMatrix& matrix, const SkIRect& clip,
+                         std::vector<uint8_t>* mask, SkIRect* bounds);
+
+#endif // QURAN_RENDERER_GLYPH_SDF_H
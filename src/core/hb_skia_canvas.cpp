@@ -25,6 +25,9 @@
 
 #include "hb_skia_canvas.h"
 
+#include <algorithm>
+#include <cmath>
+
 static void
 hb_skia_canvas_move_to (hb_draw_funcs_t *dfuncs HB_UNUSED,
                         void *data,
@@ -116,6 +119,170 @@ hb_skia_draw_get_funcs ()
     return static_skia_canvas_funcs.get_unconst ();
 }
 
+// Flattening sink: the same path commands, curves split into line segments.
+// Writes a path, or device-space segments for the glyph rasterizer.
+
+typedef struct
+{
+    SkPathBuilder *builder;         // Path output, or
+    std::vector<float> *segments;   // x0, y0, x1, y1 per line, mapped through matrix
+    SkMatrix matrix;
+    float tolerance;
+    SkPoint start;                  // Device-space contour start and pen (segments only)
+    SkPoint pen;
+} skia_flatten_t;
+
+static inline void
+hb_skia_flatten_emit_line (skia_flatten_t *f, float x, float y)
+{
+    if (f->builder)
+    {
+        f->builder->lineTo (x, y);
+        return;
+    }
+    SkPoint to = f->matrix.mapXY (x, y);
+    f->segments->insert (f->segments->end (), {f->pen.fX, f->pen.fY, to.fX, to.fY});
+    f->pen = to;
+}
+
+// A curve whose control polygon bends by `deviation` stays within tolerance
+// of n chords when deviation / n^2 <= tolerance
+static inline int
+hb_skia_flatten_segments (float deviation, float tolerance)
+{
+    if (deviation <= tolerance) return 1;
+    return std::min (64, (int) ceilf (sqrtf (deviation / tolerance)));
+}
+
+static void
+hb_skia_flatten_move_to (hb_draw_funcs_t *dfuncs HB_UNUSED,
+                         void *data,
+                         hb_draw_state_t *st,
+                         float to_x, float to_y,
+                         void *user_data HB_UNUSED)
+{
+    skia_flatten_t *f = (skia_flatten_t *) data;
+    if (f->builder)
+    {
+        f->builder->moveTo (to_x, to_y);
+        return;
+    }
+    f->start = f->pen = f->matrix.mapXY (to_x, to_y);
+}
+
+static void
+hb_skia_flatten_line_to (hb_draw_funcs_t *dfuncs HB_UNUSED,
+                         void *data,
+                         hb_draw_state_t *st,
+                         float to_x, float to_y,
+                         void *user_data HB_UNUSED)
+{
+    skia_flatten_t *f = (skia_flatten_t *) data;
+    hb_skia_flatten_emit_line (f, to_x, to_y);
+}
+
+static void
+hb_skia_flatten_quadratic_to (hb_draw_funcs_t *dfuncs HB_UNUSED,
+                              void *data,
+                              hb_draw_state_t *st,
+                              float control_x, float control_y,
+                              float to_x, float to_y,
+                              void *user_data HB_UNUSED)
+{
+    skia_flatten_t *f = (skia_flatten_t *) data;
+    const float x0 = st->current_x, y0 = st->current_y;
+
+    // Distance from the chord is at most |p0 - 2p1 + p2| / 4
+    const float ddx = x0 - 2 * control_x + to_x;
+    const float ddy = y0 - 2 * control_y + to_y;
+    const int n = hb_skia_flatten_segments (sqrtf (ddx * ddx + ddy * ddy) / 4, f->tolerance);
+
+    for (int i = 1; i < n; i++)
+    {
+        const float t = (float) i / n, mt = 1 - t;
+        hb_skia_flatten_emit_line (f, mt * mt * x0 + 2 * mt * t * control_x + t * t * to_x,
+                                      mt * mt * y0 + 2 * mt * t * control_y + t * t * to_y);
+    }
+    hb_skia_flatten_emit_line (f, to_x, to_y);
+}
+
+static void
+hb_skia_flatten_cubic_to (hb_draw_funcs_t *dfuncs HB_UNUSED,
+                          void *data,
+                          hb_draw_state_t *st,
+                          float control1_x, float control1_y,
+                          float control2_x, float control2_y,
+                          float to_x, float to_y,
+                          void *user_data HB_UNUSED)
+{
+    skia_flatten_t *f = (skia_flatten_t *) data;
+    const float x0 = st->current_x, y0 = st->current_y;
+
+    // Distance from the chord is at most 3/4 of the larger second difference
+    const float d1x = x0 - 2 * control1_x + control2_x;
+    const float d1y = y0 - 2 * control1_y + control2_y;
+    const float d2x = control1_x - 2 * control2_x + to_x;
+    const float d2y = control1_y - 2 * control2_y + to_y;
+    const float dd = std::max (d1x * d1x + d1y * d1y, d2x * d2x + d2y * d2y);
+    const int n = hb_skia_flatten_segments (0.75f * sqrtf (dd), f->tolerance);
+
+    for (int i = 1; i < n; i++)
+    {
+        const float t = (float) i / n, mt = 1 - t;
+        const float a = mt * mt * mt, b = 3 * mt * mt * t, c = 3 * mt * t * t, d = t * t * t;
+        hb_skia_flatten_emit_line (f, a * x0 + b * control1_x + c * control2_x + d * to_x,
+                                      a * y0 + b * control1_y + c * control2_y + d * to_y);
+    }
+    hb_skia_flatten_emit_line (f, to_x, to_y);
+}
+
+static void
+hb_skia_flatten_close_path (hb_draw_funcs_t *dfuncs HB_UNUSED,
+                            void *data,
+                            hb_draw_state_t *st,
+                            void *user_data HB_UNUSED)
+{
+    skia_flatten_t *f = (skia_flatten_t *) data;
+    if (f->builder)
+    {
+        f->builder->close ();
+        return;
+    }
+    if (f->pen.fX != f->start.fX || f->pen.fY != f->start.fY)
+    {
+        f->segments->insert (f->segments->end (), {f->pen.fX, f->pen.fY, f->start.fX, f->start.fY});
+        f->pen = f->start;
+    }
+}
+
+static inline void free_static_skia_flatten_funcs();
+
+static struct hb_skia_flatten_funcs_lazy_loader_t : hb_draw_funcs_lazy_loader_t<hb_skia_flatten_funcs_lazy_loader_t>
+{
+    static hb_draw_funcs_t *create ()
+    {
+        hb_draw_funcs_t *funcs = hb_draw_funcs_create ();
+
+        hb_draw_funcs_set_move_to_func (funcs, hb_skia_flatten_move_to, nullptr, nullptr);
+        hb_draw_funcs_set_line_to_func (funcs, hb_skia_flatten_line_to, nullptr, nullptr);
+        hb_draw_funcs_set_quadratic_to_func (funcs, hb_skia_flatten_quadratic_to, nullptr, nullptr);
+        hb_draw_funcs_set_cubic_to_func (funcs, hb_skia_flatten_cubic_to, nullptr, nullptr);
+        hb_draw_funcs_set_close_path_func (funcs, hb_skia_flatten_close_path, nullptr, nullptr);
+
+        hb_draw_funcs_make_immutable (funcs);
+
+        hb_atexit (free_static_skia_flatten_funcs);
+
+        return funcs;
+    }
+} static_skia_flatten_funcs;
+
+static inline
+void free_static_skia_flatten_funcs ()
+{
+    static_skia_flatten_funcs.free_instance ();
+}
+
 static void
 hb_skia_push_clip_glyph (hb_paint_funcs_t *pfuncs HB_UNUSED,
                           void *paint_data,
@@ -125,18 +292,33 @@ hb_skia_push_clip_glyph (hb_paint_funcs_t *pfuncs HB_UNUSED,
 {
     skia_context_t *c = (skia_context_t *) paint_data;
 
+    c->path_in_device = c->device_outline &&
+                        c->device_outline (c->device_outline_data, c->canvas, font, glyph,
+                                           &c->path, &c->path_matrix);
+    if (c->path_in_device)
+        return;
+
     SkPathBuilder pathBuilder;
-    hb_font_draw_glyph (font, glyph, hb_skia_draw_get_funcs (), &pathBuilder);
+    hb_skia_flatten_glyph (font, glyph, &pathBuilder, c->flatten_tolerance);
     SkPath newPath = pathBuilder.detach();
     c->path = newPath;
 }
 
-// Check if a color is near-white (within tolerance)
-static bool isNearWhite(hb_color_t color, int tolerance = 10) {
-    int r = hb_color_get_red(color);
-    int g = hb_color_get_green(color);
-    int b = hb_color_get_blue(color);
-    return (r >= 255 - tolerance && g >= 255 - tolerance && b >= 255 - tolerance);
+// Palette colors come from the context's resolved table rather than CPAL, so
+// themes and background remaps cost one index per color lookup
+static hb_bool_t
+hb_skia_custom_palette_color (hb_paint_funcs_t *pfuncs HB_UNUSED,
+                               void *paint_data,
+                               unsigned int color_index,
+                               hb_color_t *color,
+                               void *user_data HB_UNUSED)
+{
+    skia_context_t *c = (skia_context_t *) paint_data;
+    if (color_index >= c->palette_size) {
+        return false;
+    }
+    *color = c->palette[color_index];
+    return true;
 }
 
 static void
@@ -151,21 +333,10 @@ hb_skia_paint_color (hb_paint_funcs_t *pfuncs HB_UNUSED,
     // Determine which color to use:
     // - If use_foreground_override is set (tajweed OFF), always use the foreground color
     // - If HarfBuzz says use_foreground, use the foreground color
-    // - Otherwise use the embedded font color (for tajweed and COLR glyphs)
-    //
-    // Special handling for COLR glyphs (ayah numbers):
-    // - White fills (colorID 1) are remapped to match the canvas background
-    // - This makes the ayah glyph's internal background transparent to the page
-    hb_color_t finalColor;
-    if (c->use_foreground_override || use_foreground) {
-        finalColor = c->foreground;
-    } else if (isNearWhite(color)) {
-        // Remap white COLR fills to the canvas background color
-        // This makes ayah glyphs adapt to dark/light backgrounds
-        finalColor = c->backgroundColor;
-    } else {
-        finalColor = color;
-    }
+    // - Otherwise use the palette color (for tajweed and COLR glyphs), already
+    //   resolved through hb_skia_custom_palette_color. White fills of the ayah
+    //   glyphs were remapped to the canvas background there.
+    hb_color_t finalColor = (c->use_foreground_override || use_foreground) ? c->foreground : color;
     
     c->paint->setColor(SkColorSetARGB(
         hb_color_get_alpha(finalColor), 
@@ -173,6 +344,14 @@ hb_skia_paint_color (hb_paint_funcs_t *pfuncs HB_UNUSED,
         hb_color_get_green(finalColor), 
         hb_color_get_blue(finalColor)
     ));
+    if (c->path_in_device)
+    {
+        c->canvas->save ();
+        c->canvas->setMatrix (c->path_matrix);
+        c->canvas->drawPath (c->path, *c->paint);
+        c->canvas->restore ();
+        return;
+    }
     c->canvas->drawPath(c->path, *c->paint);
 }
 
@@ -194,6 +373,7 @@ static struct hb_skia_paint_funcs_lazy_loader_t : hb_paint_funcs_lazy_loader_t<h
 
         hb_paint_funcs_set_push_clip_glyph_func (paint_funcs, hb_skia_push_clip_glyph, nullptr, nullptr);
         hb_paint_funcs_set_color_func (paint_funcs, hb_skia_paint_color, nullptr, nullptr);
+        hb_paint_funcs_set_custom_palette_color_func (paint_funcs, hb_skia_custom_palette_color, nullptr, nullptr);
         hb_paint_funcs_set_pop_clip_func (paint_funcs, hb_skia_pop_clip, nullptr, nullptr);
 
         hb_paint_funcs_make_immutable (paint_funcs);
@@ -234,3 +414,29 @@ void hb_skia_render_glyph (hb_font_t *font, hb_codepoint_t glyph, void *draw_dat
 {
     hb_font_draw_glyph (font, glyph, hb_skia_draw_get_funcs(), draw_data);
 }
+
+void hb_skia_flatten_glyph (hb_font_t *font, hb_codepoint_t glyph,
+                            SkPathBuilder *builder, float tolerance)
+{
+    if (tolerance <= 0)
+    {
+        hb_font_draw_glyph (font, glyph, hb_skia_draw_get_funcs (), builder);
+        return;
+    }
+
+    skia_flatten_t flatten = {};
+    flatten.builder = builder;
+    flatten.tolerance = tolerance;
+    hb_font_draw_glyph (font, glyph, static_skia_flatten_funcs.get_unconst (), &flatten);
+}
+
+void hb_skia_glyph_segments (hb_font_t *font, hb_codepoint_t glyph,
+                             const SkMatrix &matrix, float tolerance,
+                             std::vector<float> *segments)
+{
+    skia_flatten_t flatten = {};
+    flatten.segments = segments;
+    flatten.matrix = matrix;
+    flatten.tolerance = tolerance;
+    hb_font_draw_glyph (font, glyph, static_skia_flatten_funcs.get_unconst (), &flatten);
+}
@@ -6,8 +6,11 @@
 #define QURAN_RENDERER_HB_SKIA_CANVAS_H
 
 #include <hb.h>
+#include <vector>
 #include "SkCanvas.h"
+#include "SkMatrix.h"
 #include "SkPath.h"
+#include "SkPathBuilder.h"
 
 typedef struct
 {
@@ -15,8 +18,19 @@ typedef struct
     SkPath path;
     SkPaint * paint;
     hb_color_t foreground;          // Foreground color for text
-    hb_color_t backgroundColor;     // Background color for remapping COLR white fills
+    const hb_color_t *palette;      // Resolved CPAL colors of the painted font (white fills = background)
+    unsigned int palette_size;      // 0 = use the font's own palette
     bool use_foreground_override;   // If true, keep foreground fixed (do not update per glyph)
+    float flatten_tolerance;        // Curves become lines within this distance (glyph units), 0 = keep curves
+
+    // Optional source of glyph outlines already in device space: sets the
+    // path and the (whole-pixel translation) matrix to draw it with, or
+    // returns false to build the outline in glyph units
+    bool (*device_outline) (void *data, SkCanvas *canvas, hb_font_t *font, hb_codepoint_t glyph,
+                            SkPath *path, SkMatrix *matrix);
+    void *device_outline_data;
+    bool path_in_device;            // path came from device_outline, drawn with path_matrix
+    SkMatrix path_matrix;
 } skia_context_t;
 
 void hb_skia_paint_glyph (hb_font_t *font,
@@ -26,6 +40,17 @@ void hb_skia_paint_glyph (hb_font_t *font,
 
 void hb_skia_render_glyph (hb_font_t *font, hb_codepoint_t glyph, void *draw_data);
 
+// Glyph outline with curves flattened into lines, none farther than tolerance
+// from the curve (glyph units). tolerance <= 0 keeps the curves.
+void hb_skia_flatten_glyph (hb_font_t *font, hb_codepoint_t glyph,
+                            SkPathBuilder *builder, float tolerance);
+
+// Glyph outline as line segments (x0, y0, x1, y1) mapped through matrix, for
+// GlyphRasterizer. Curves are always flattened; tolerance must be > 0.
+void hb_skia_glyph_segments (hb_font_t *font, hb_codepoint_t glyph,
+                             const SkMatrix &matrix, float tolerance,
+                             std::vector<float> *segments);
+
 hb_draw_funcs_t * hb_skia_draw_get_funcs ();
 hb_paint_funcs_t * hb_skia_paint_get_funcs ();
 
@@ -0,0 +1,121 @@
+/**
+ * LRU cache with a byte budget
+ *
+ * Values are handed out as shared_ptr, so an entry evicted while a caller
+ * still uses it stays alive until that caller is done. All operations take
+ * an internal lock and may be called from several threads.
+ */
+
+#ifndef QURAN_RENDERER_LRU_CACHE_H
+#define QURAN_RENDERER_LRU_CACHE_H
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class LruCache {
+public:
+    explicit LruCache(size_t byteBudget) : budget(byteBudget) {}
+
+    LruCache(const LruCache&) = delete;
+    LruCache& operator=(const LruCache&) = delete;
+
+    // Returns the cached value and marks it most recently used, or nullptr
+    std::shared_ptr<const Value> get(const Key& key) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = index.find(key);
+        if (it == index.end()) {
+            misses++;
+            return nullptr;
+        }
+        entries.splice(entries.begin(), entries, it->second);
+        hits++;
+        return it->second->value;
+    }
+
+    // Inserts or replaces a value costing `bytes`, then evicts least recently
+    // used entries until the budget holds. A value larger than the whole
+    // budget is not cached.
+    void put(const Key& key, std::shared_ptr<const Value> value, size_t bytes) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = index.find(key);
+        if (it != index.end()) {
+            used -= it->second->bytes;
+            entries.erase(it->second);
+            index.erase(it);
+        }
+        if (bytes > budget) {
+            return;
+        }
+
+        entries.push_front({key, std::move(value), bytes});
+        index.emplace(key, entries.begin());
+        used += bytes;
+        evict();
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex);
+        entries.clear();
+        index.clear();
+        used = 0;
+    }
+
+    void setBudget(size_t byteBudget) {
+        std::lock_guard<std::mutex> lock(mutex);
+        budget = byteBudget;
+        evict();
+    }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return entries.size();
+    }
+
+    size_t bytes() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return used;
+    }
+
+    size_t hitCount() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return hits;
+    }
+
+    size_t missCount() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return misses;
+    }
+
+private:
+    struct Entry {
+        Key key;
+        std::shared_ptr<const Value> value;
+        size_t bytes;
+    };
+
+    // Caller holds the lock
+    void evict() {
+        while (used > budget && !entries.empty()) {
+            const Entry& last = entries.back();
+            used -= last.bytes;
+            index.erase(last.key);
+            entries.pop_back();
+        }
+    }
+
+    std::list<Entry> entries;   // Most recently used first
+    std::unordered_map<Key, typename std::list<Entry>::iterator, Hash> index;
+    size_t budget;
+    size_t used = 0;
+    size_t hits = 0;
+    size_t misses = 0;
+    mutable std::mutex mutex;
+};
+
+#endif // QURAN_RENDERER_LRU_CACHE_H
@@ -1,6 +1,7 @@
 /**
  * Quran Metadata - Surah and Page information
- * Auto-generated from quranmetadata.json and pages.json
+ * Auto-generated from quranmetadata.json, pages.json and quarters.json
+ * by scripts/generate-metadata.py - do not edit by hand
  */
 
 #ifndef QURAN_METADATA_H
@@ -874,4 +875,304 @@ static const PageLocation PAGE_LOCATIONS[604] = {
     {112, 1},   // Page 603
 };
 
+// Juz / hizb / rub al-hizb counts
+static constexpr int QURAN_JUZ_COUNT = 30;
+static constexpr int QURAN_HIZB_COUNT = 60;
+static constexpr int QURAN_RUB_COUNT = 240;
+
+// Rub al-hizb (hizb quarter) start location and the page it starts on
+struct RubLocation {
+    int surahNumber;
+    int ayahNumber;
+    int pageIndex;
+};
+
+// Rub start locations (0-indexed rub array)
+// Rub r starts hizb r/4+1 when r%4 == 0 and juz r/8+1 when r%8 == 0
+static const RubLocation RUB_LOCATIONS[240] = {
+    {1, 1, 0},   // Rub 1 (Juz 1, Hizb 1)
+    {2, 26, 4},   // Rub 2 (Juz 1, Hizb 1)
+    {2, 44, 6},   // Rub 3 (Juz 1, Hizb 1)
+    {2, 60, 8},   // Rub 4 (Juz 1, Hizb 1)
+    {2, 75, 10},   // Rub 5 (Juz 1, Hizb 2)
+    {2, 92, 13},   // Rub 6 (Juz 1, Hizb 2)
+    {2, 106, 16},   // Rub 7 (Juz 1, Hizb 2)
+    {2, 124, 18},   // Rub 8 (Juz 1, Hizb 2)
+    {2, 142, 21},   // Rub 9 (Juz 2, Hizb 3)
+    {2, 158, 23},   // Rub 10 (Juz 2, Hizb 3)
+    {2, 177, 26},   // Rub 11 (Juz 2, Hizb 3)
+    {2, 189, 28},   // Rub 12 (Juz 2, Hizb 3)
+    {2, 203, 31},   // Rub 13 (Juz 2, Hizb 4)
+    {2, 219, 33},   // Rub 14 (Juz 2, Hizb 4)
+    {2, 233, 36},   // Rub 15 (Juz 2, Hizb 4)
+    {2, 243, 38},   // Rub 16 (Juz 2, Hizb 4)
+    {2, 253, 41},   // Rub 17 (Juz 3, Hizb 5)
+    {2, 263, 43},   // Rub 18 (Juz 3, Hizb 5)
+    {2, 272, 45},   // Rub 19 (Juz 3, Hizb 5)
+    {2, 283, 48},   // Rub 20 (Juz 3, Hizb 5)
+    {3, 15, 50},   // Rub 21 (Juz 3, Hizb 6)
+    {3, 33, 53},   // Rub 22 (Juz 3, Hizb 6)
+    {3, 52, 55},   // Rub 23 (Juz 3, Hizb 6)
+    {3, 75, 58},   // Rub 24 (Juz 3, Hizb 6)
+    {3, 93, 61},   // Rub 25 (Juz 4, Hizb 7)
+    {3, 113, 63},   // Rub 26 (Juz 4, Hizb 7)
+    {3, 133, 66},   // Rub 27 (Juz 4, Hizb 7)
+    {3, 153, 68},   // Rub 28 (Juz 4, Hizb 7)
+    {3, 171, 71},   // Rub 29 (Juz 4, Hizb 8)
+    {3, 186, 73},   // Rub 30 (Juz 4, Hizb 8)
+    {4, 1, 76},   // Rub 31 (Juz 4, Hizb 8)
+    {4, 12, 78},   // Rub 32 (Juz 4, Hizb 8)
+    {4, 24, 81},   // Rub 33 (Juz 5, Hizb 9)
+    {4, 36, 83},   // Rub 34 (Juz 5, Hizb 9)
+    {4, 58, 86},   // Rub 35 (Juz 5, Hizb 9)
+    {4, 74, 88},   // Rub 36 (Juz 5, Hizb 9)
+    {4, 88, 91},   // Rub 37 (Juz 5, Hizb 10)
+    {4, 100, 93},   // Rub 38 (Juz 5, Hizb 10)
+    {4, 114, 96},   // Rub 39 (Juz 5, Hizb 10)
+    {4, 135, 99},   // Rub 40 (Juz 5, Hizb 10)
+    {4, 148, 101},   // Rub 41 (Juz 6, Hizb 11)
+    {4, 163, 103},   // Rub 42 (Juz 6, Hizb 11)
+    {5, 1, 105},   // Rub 43 (Juz 6, Hizb 11)
+    {5, 12, 108},   // Rub 44 (Juz 6, Hizb 11)
+    {5, 27, 111},   // Rub 45 (Juz 6, Hizb 12)
+    {5, 41, 113},   // Rub 46 (Juz 6, Hizb 12)
+    {5, 51, 116},   // Rub 47 (Juz 6, Hizb 12)
+    {5, 67, 118},   // Rub 48 (Juz 6, Hizb 12)
+    {5, 82, 120},   // Rub 49 (Juz 7, Hizb 13)
+    {5, 97, 123},   // Rub 50 (Juz 7, Hizb 13)
+    {5, 109, 125},   // Rub 51 (Juz 7, Hizb 13)
+    {6, 13, 128},   // Rub 52 (Juz 7, Hizb 13)
+    {6, 36, 131},   // Rub 53 (Juz 7, Hizb 14)
+    {6, 59, 133},   // Rub 54 (Juz 7, Hizb 14)
+    {6, 74, 136},   // Rub 55 (Juz 7, Hizb 14)
+    {6, 95, 139},   // Rub 56 (Juz 7, Hizb 14)
+    {6, 111, 141},   // Rub 57 (Juz 8, Hizb 15)
+    {6, 127, 143},   // Rub 58 (Juz 8, Hizb 15)
+    {6, 141, 145},   // Rub 59 (Juz 8, Hizb 15)
+    {6, 151, 147},   // Rub 60 (Juz 8, Hizb 15)
+    {7, 1, 150},   // Rub 61 (Juz 8, Hizb 16)
+    {7, 31, 153},   // Rub 62 (Juz 8, Hizb 16)
+    {7, 47, 155},   // Rub 63 (Juz 8, Hizb 16)
+    {7, 65, 157},   // Rub 64 (Juz 8, Hizb 16)
+    {7, 88, 161},   // Rub 65 (Juz 9, Hizb 17)
+    {7, 117, 163},   // Rub 66 (Juz 9, Hizb 17)
+    {7, 142, 166},   // Rub 67 (Juz 9, Hizb 17)
+    {7, 156, 169},   // Rub 68 (Juz 9, Hizb 17)
+    {7, 171, 172},   // Rub 69 (Juz 9, Hizb 18)
+    {7, 189, 174},   // Rub 70 (Juz 9, Hizb 18)
+    {8, 1, 176},   // Rub 71 (Juz 9, Hizb 18)
+    {8, 22, 178},   // Rub 72 (Juz 9, Hizb 18)
+    {8, 41, 181},   // Rub 73 (Juz 10, Hizb 19)
+    {8, 61, 183},   // Rub 74 (Juz 10, Hizb 19)
+    {9, 1, 186},   // Rub 75 (Juz 10, Hizb 19)
+    {9, 19, 188},   // Rub 76 (Juz 10, Hizb 19)
+    {9, 34, 191},   // Rub 77 (Juz 10, Hizb 20)
+    {9, 46, 193},   // Rub 78 (Juz 10, Hizb 20)
+    {9, 60, 195},   // Rub 79 (Juz 10, Hizb 20)
+    {9, 75, 198},   // Rub 80 (Juz 10, Hizb 20)
+    {9, 93, 200},   // Rub 81 (Juz 11, Hizb 21)
+    {9, 111, 203},   // Rub 82 (Juz 11, Hizb 21)
+    {9, 122, 205},   // Rub 83 (Juz 11, Hizb 21)
+    {10, 11, 208},   // Rub 84 (Juz 11, Hizb 21)
+    {10, 26, 211},   // Rub 85 (Juz 11, Hizb 22)
+    {10, 53, 213},   // Rub 86 (Juz 11, Hizb 22)
+    {10, 71, 216},   // Rub 87 (Juz 11, Hizb 22)
+    {10, 90, 218},   // Rub 88 (Juz 11, Hizb 22)
+    {11, 6, 221},   // Rub 89 (Juz 12, Hizb 23)
+    {11, 24, 223},   // Rub 90 (Juz 12, Hizb 23)
+    {11, 41, 225},   // Rub 91 (Juz 12, Hizb 23)
+    {11, 61, 227},   // Rub 92 (Juz 12, Hizb 23)
+    {11, 84, 230},   // Rub 93 (Juz 12, Hizb 24)
+    {11, 108, 232},   // Rub 94 (Juz 12, Hizb 24)
+    {12, 7, 235},   // Rub 95 (Juz 12, Hizb 24)
+    {12, 30, 237},   // Rub 96 (Juz 12, Hizb 24)
+    {12, 53, 241},   // Rub 97 (Juz 13, Hizb 25)
+    {12, 77, 243},   // Rub 98 (Juz 13, Hizb 25)
+    {12, 101, 246},   // Rub 99 (Juz 13, Hizb 25)
+    {13, 5, 248},   // Rub 100 (Juz 13, Hizb 25)
+    {13, 19, 251},   // Rub 101 (Juz 13, Hizb 26)
+    {13, 35, 253},   // Rub 102 (Juz 13, Hizb 26)
+    {14, 10, 255},   // Rub 103 (Juz 13, Hizb 26)
+    {14, 28, 258},   // Rub 104 (Juz 13, Hizb 26)
+    {15, 1, 261},   // Rub 105 (Juz 14, Hizb 27)
+    {15, 50, 263},   // Rub 106 (Juz 14, Hizb 27)
+    {16, 1, 266},   // Rub 107 (Juz 14, Hizb 27)
+    {16, 30, 269},   // Rub 108 (Juz 14, Hizb 27)
+    {16, 51, 271},   // Rub 109 (Juz 14, Hizb 28)
+    {16, 75, 274},   // Rub 110 (Juz 14, Hizb 28)
+    {16, 90, 276},   // Rub 111 (Juz 14, Hizb 28)
+    {16, 111, 279},   // Rub 112 (Juz 14, Hizb 28)
+    {17, 1, 281},   // Rub 113 (Juz 15, Hizb 29)
+    {17, 23, 283},   // Rub 114 (Juz 15, Hizb 29)
+    {17, 50, 286},   // Rub 115 (Juz 15, Hizb 29)
+    {17, 70, 288},   // Rub 116 (Juz 15, Hizb 29)
+    {17, 99, 291},   // Rub 117 (Juz 15, Hizb 30)
+    {18, 17, 294},   // Rub 118 (Juz 15, Hizb 30)
+    {18, 32, 296},   // Rub 119 (Juz 15, Hizb 30)
+    {18, 51, 298},   // Rub 120 (Juz 15, Hizb 30)
+    {18, 75, 301},   // Rub 121 (Juz 16, Hizb 31)
+    {18, 99, 303},   // Rub 122 (Juz 16, Hizb 31)
+    {19, 22, 305},   // Rub 123 (Juz 16, Hizb 31)
+    {19, 59, 308},   // Rub 124 (Juz 16, Hizb 31)
+    {20, 1, 311},   // Rub 125 (Juz 16, Hizb 32)
+    {20, 55, 314},   // Rub 126 (Juz 16, Hizb 32)
+    {20, 83, 316},   // Rub 127 (Juz 16, Hizb 32)
+    {20, 111, 318},   // Rub 128 (Juz 16, Hizb 32)
+    {21, 1, 321},   // Rub 129 (Juz 17, Hizb 33)
+    {21, 29, 323},   // Rub 130 (Juz 17, Hizb 33)
+    {21, 51, 325},   // Rub 131 (Juz 17, Hizb 33)
+    {21, 83, 328},   // Rub 132 (Juz 17, Hizb 33)
+    {22, 1, 331},   // Rub 133 (Juz 17, Hizb 34)
+    {22, 19, 333},   // Rub 134 (Juz 17, Hizb 34)
+    {22, 38, 335},   // Rub 135 (Juz 17, Hizb 34)
+    {22, 60, 338},   // Rub 136 (Juz 17, Hizb 34)
+    {23, 1, 341},   // Rub 137 (Juz 18, Hizb 35)
+    {23, 36, 343},   // Rub 138 (Juz 18, Hizb 35)
+    {23, 75, 346},   // Rub 139 (Juz 18, Hizb 35)
+    {24, 1, 349},   // Rub 140 (Juz 18, Hizb 35)
+    {24, 21, 351},   // Rub 141 (Juz 18, Hizb 36)
+    {24, 35, 353},   // Rub 142 (Juz 18, Hizb 36)
+    {24, 53, 355},   // Rub 143 (Juz 18, Hizb 36)
+    {25, 1, 358},   // Rub 144 (Juz 18, Hizb 36)
+    {25, 21, 361},   // Rub 145 (Juz 19, Hizb 37)
+    {25, 53, 363},   // Rub 146 (Juz 19, Hizb 37)
+    {26, 1, 366},   // Rub 147 (Juz 19, Hizb 37)
+    {26, 52, 368},   // Rub 148 (Juz 19, Hizb 37)
+    {26, 111, 370},   // Rub 149 (Juz 19, Hizb 38)
+    {26, 181, 373},   // Rub 150 (Juz 19, Hizb 38)
+    {27, 1, 376},   // Rub 151 (Juz 19, Hizb 38)
+    {27, 27, 378},   // Rub 152 (Juz 19, Hizb 38)
+    {27, 56, 381},   // Rub 153 (Juz 20, Hizb 39)
+    {27, 82, 383},   // Rub 154 (Juz 20, Hizb 39)
+    {28, 12, 385},   // Rub 155 (Juz 20, Hizb 39)
+    {28, 29, 388},   // Rub 156 (Juz 20, Hizb 39)
+    {28, 51, 391},   // Rub 157 (Juz 20, Hizb 40)
+    {28, 76, 393},   // Rub 158 (Juz 20, Hizb 40)
+    {29, 1, 395},   // Rub 159 (Juz 20, Hizb 40)
+    {29, 26, 398},   // Rub 160 (Juz 20, Hizb 40)
+    {29, 46, 401},   // Rub 161 (Juz 21, Hizb 41)
+    {30, 1, 403},   // Rub 162 (Juz 21, Hizb 41)
+    {30, 31, 406},   // Rub 163 (Juz 21, Hizb 41)
+    {30, 54, 409},   // Rub 164 (Juz 21, Hizb 41)
+    {31, 22, 412},   // Rub 165 (Juz 21, Hizb 42)
+    {32, 11, 414},   // Rub 166 (Juz 21, Hizb 42)
+    {33, 1, 417},   // Rub 167 (Juz 21, Hizb 42)
+    {33, 18, 419},   // Rub 168 (Juz 21, Hizb 42)
+    {33, 31, 421},   // Rub 169 (Juz 22, Hizb 43)
+    {33, 51, 424},   // Rub 170 (Juz 22, Hizb 43)
+    {33, 60, 425},   // Rub 171 (Juz 22, Hizb 43)
+    {34, 10, 428},   // Rub 172 (Juz 22, Hizb 43)
+    {34, 24, 430},   // Rub 173 (Juz 22, Hizb 44)
+    {34, 46, 432},   // Rub 174 (Juz 22, Hizb 44)
+    {35, 15, 435},   // Rub 175 (Juz 22, Hizb 44)
+    {35, 41, 438},   // Rub 176 (Juz 22, Hizb 44)
+    {36, 28, 441},   // Rub 177 (Juz 23, Hizb 45)
+    {36, 60, 443},   // Rub 178 (Juz 23, Hizb 45)
+    {37, 22, 445},   // Rub 179 (Juz 23, Hizb 45)
+    {37, 83, 448},   // Rub 180 (Juz 23, Hizb 45)
+    {37, 145, 450},   // Rub 181 (Juz 23, Hizb 46)
+    {38, 21, 453},   // Rub 182 (Juz 23, Hizb 46)
+    {38, 52, 455},   // Rub 183 (Juz 23, Hizb 46)
+    {39, 8, 458},   // Rub 184 (Juz 23, Hizb 46)
+    {39, 32, 461},   // Rub 185 (Juz 24, Hizb 47)
+    {39, 53, 463},   // Rub 186 (Juz 24, Hizb 47)
+    {40, 1, 466},   // Rub 187 (Juz 24, Hizb 47)
+    {40, 21, 468},   // Rub 188 (Juz 24, Hizb 47)
+    {40, 41, 471},   // Rub 189 (Juz 24, Hizb 48)
+    {40, 66, 473},   // Rub 190 (Juz 24, Hizb 48)
+    {41, 9, 476},   // Rub 191 (Juz 24, Hizb 48)
+    {41, 25, 478},   // Rub 192 (Juz 24, Hizb 48)
+    {41, 47, 481},   // Rub 193 (Juz 25, Hizb 49)
+    {42, 13, 483},   // Rub 194 (Juz 25, Hizb 49)
+    {42, 27, 485},   // Rub 195 (Juz 25, Hizb 49)
+    {42, 51, 487},   // Rub 196 (Juz 25, Hizb 49)
+    {43, 24, 490},   // Rub 197 (Juz 25, Hizb 50)
+    {43, 57, 492},   // Rub 198 (Juz 25, Hizb 50)
+    {44, 17, 495},   // Rub 199 (Juz 25, Hizb 50)
+    {45, 12, 498},   // Rub 200 (Juz 25, Hizb 50)
+    {46, 1, 501},   // Rub 201 (Juz 26, Hizb 51)
+    {46, 21, 504},   // Rub 202 (Juz 26, Hizb 51)
+    {47, 10, 506},   // Rub 203 (Juz 26, Hizb 51)
+    {47, 33, 509},   // Rub 204 (Juz 26, Hizb 51)
+    {48, 18, 512},   // Rub 205 (Juz 26, Hizb 52)
+    {49, 1, 514},   // Rub 206 (Juz 26, Hizb 52)
+    {49, 14, 516},   // Rub 207 (Juz 26, Hizb 52)
+    {50, 27, 518},   // Rub 208 (Juz 26, Hizb 52)
+    {51, 31, 521},   // Rub 209 (Juz 27, Hizb 53)
+    {52, 24, 523},   // Rub 210 (Juz 27, Hizb 53)
+    {53, 26, 525},   // Rub 211 (Juz 27, Hizb 53)
+    {54, 9, 528},   // Rub 212 (Juz 27, Hizb 53)
+    {55, 1, 530},   // Rub 213 (Juz 27, Hizb 54)
+    {56, 1, 533},   // Rub 214 (Juz 27, Hizb 54)
+    {56, 75, 535},   // Rub 215 (Juz 27, Hizb 54)
+    {57, 16, 538},   // Rub 216 (Juz 27, Hizb 54)
+    {58, 1, 541},   // Rub 217 (Juz 28, Hizb 55)
+    {58, 14, 543},   // Rub 218 (Juz 28, Hizb 55)
+    {59, 11, 546},   // Rub 219 (Juz 28, Hizb 55)
+    {60, 7, 549},   // Rub 220 (Juz 28, Hizb 55)
+    {62, 1, 552},   // Rub 221 (Juz 28, Hizb 56)
+    {63, 4, 553},   // Rub 222 (Juz 28, Hizb 56)
+    {65, 1, 557},   // Rub 223 (Juz 28, Hizb 56)
+    {66, 1, 559},   // Rub 224 (Juz 28, Hizb 56)
+    {67, 1, 561},   // Rub 225 (Juz 29, Hizb 57)
+    {68, 1, 563},   // Rub 226 (Juz 29, Hizb 57)
+    {69, 1, 565},   // Rub 227 (Juz 29, Hizb 57)
+    {70, 19, 568},   // Rub 228 (Juz 29, Hizb 57)
+    {72, 1, 571},   // Rub 229 (Juz 29, Hizb 58)
+    {73, 20, 574},   // Rub 230 (Juz 29, Hizb 58)
+    {75, 1, 576},   // Rub 231 (Juz 29, Hizb 58)
+    {76, 19, 578},   // Rub 232 (Juz 29, Hizb 58)
+    {78, 1, 581},   // Rub 233 (Juz 30, Hizb 59)
+    {80, 1, 584},   // Rub 234 (Juz 30, Hizb 59)
+    {82, 1, 586},   // Rub 235 (Juz 30, Hizb 59)
+    {84, 1, 588},   // Rub 236 (Juz 30, Hizb 59)
+    {87, 1, 590},   // Rub 237 (Juz 30, Hizb 60)
+    {90, 1, 593},   // Rub 238 (Juz 30, Hizb 60)
+    {94, 1, 595},   // Rub 239 (Juz 30, Hizb 60)
+    {100, 9, 598},   // Rub 240 (Juz 30, Hizb 60)
+};
+
+// Last rub (0-indexed) starting on or before each page (0-indexed page array)
+// Juz = rub/8+1, hizb = rub/4+1
+static const uint8_t PAGE_RUBS[604] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 4, 5, 5, 5,   // Pages 0-15
+    6, 6, 7, 7, 7, 8, 8, 9, 9, 9, 10, 10, 11, 11, 11, 12,   // Pages 16-31
+    12, 13, 13, 13, 14, 14, 15, 15, 15, 16, 16, 17, 17, 18, 18, 18,   // Pages 32-47
+    19, 19, 20, 20, 20, 21, 21, 22, 22, 22, 23, 23, 23, 24, 24, 25,   // Pages 48-63
+    25, 25, 26, 26, 27, 27, 27, 28, 28, 29, 29, 29, 30, 30, 31, 31,   // Pages 64-79
+    31, 32, 32, 33, 33, 33, 34, 34, 35, 35, 35, 36, 36, 37, 37, 37,   // Pages 80-95
+    38, 38, 38, 39, 39, 40, 40, 41, 41, 42, 42, 42, 43, 43, 43, 44,   // Pages 96-111
+    44, 45, 45, 45, 46, 46, 47, 47, 48, 48, 48, 49, 49, 50, 50, 50,   // Pages 112-127
+    51, 51, 51, 52, 52, 53, 53, 53, 54, 54, 54, 55, 55, 56, 56, 57,   // Pages 128-143
+    57, 58, 58, 59, 59, 59, 60, 60, 60, 61, 61, 62, 62, 63, 63, 63,   // Pages 144-159
+    63, 64, 64, 65, 65, 65, 66, 66, 66, 67, 67, 67, 68, 68, 69, 69,   // Pages 160-175
+    70, 70, 71, 71, 71, 72, 72, 73, 73, 73, 74, 74, 75, 75, 75, 76,   // Pages 176-191
+    76, 77, 77, 78, 78, 78, 79, 79, 80, 80, 80, 81, 81, 82, 82, 82,   // Pages 192-207
+    83, 83, 83, 84, 84, 85, 85, 85, 86, 86, 87, 87, 87, 88, 88, 89,   // Pages 208-223
+    89, 90, 90, 91, 91, 91, 92, 92, 93, 93, 93, 94, 94, 95, 95, 95,   // Pages 224-239
+    95, 96, 96, 97, 97, 97, 98, 98, 99, 99, 99, 100, 100, 101, 101, 102,   // Pages 240-255
+    102, 102, 103, 103, 103, 104, 104, 105, 105, 105, 106, 106, 106, 107, 107, 108,   // Pages 256-271
+    108, 108, 109, 109, 110, 110, 110, 111, 111, 112, 112, 113, 113, 113, 114, 114,   // Pages 272-287
+    115, 115, 115, 116, 116, 116, 117, 117, 118, 118, 119, 119, 119, 120, 120, 121,   // Pages 288-303
+    121, 122, 122, 122, 123, 123, 123, 124, 124, 124, 125, 125, 126, 126, 127, 127,   // Pages 304-319
+    127, 128, 128, 129, 129, 130, 130, 130, 131, 131, 131, 132, 132, 133, 133, 134,   // Pages 320-335
+    134, 134, 135, 135, 135, 136, 136, 137, 137, 137, 138, 138, 138, 139, 139, 140,   // Pages 336-351
+    140, 141, 141, 142, 142, 142, 143, 143, 143, 144, 144, 145, 145, 145, 146, 146,   // Pages 352-367
+    147, 147, 148, 148, 148, 149, 149, 149, 150, 150, 151, 151, 151, 152, 152, 153,   // Pages 368-383
+    153, 154, 154, 154, 155, 155, 155, 156, 156, 157, 157, 158, 158, 158, 159, 159,   // Pages 384-399
+    159, 160, 160, 161, 161, 161, 162, 162, 162, 163, 163, 163, 164, 164, 165, 165,   // Pages 400-415
+    165, 166, 166, 167, 167, 168, 168, 168, 169, 170, 170, 170, 171, 171, 172, 172,   // Pages 416-431
+    173, 173, 173, 174, 174, 174, 175, 175, 175, 176, 176, 177, 177, 178, 178, 178,   // Pages 432-447
+    179, 179, 180, 180, 180, 181, 181, 182, 182, 182, 183, 183, 183, 184, 184, 185,   // Pages 448-463
+    185, 185, 186, 186, 187, 187, 187, 188, 188, 189, 189, 189, 190, 190, 191, 191,   // Pages 464-479
+    191, 192, 192, 193, 193, 194, 194, 195, 195, 195, 196, 196, 197, 197, 197, 198,   // Pages 480-495
+    198, 198, 199, 199, 199, 200, 200, 200, 201, 201, 202, 202, 202, 203, 203, 203,   // Pages 496-511
+    204, 204, 205, 205, 206, 206, 207, 207, 207, 208, 208, 209, 209, 210, 210, 210,   // Pages 512-527
+    211, 211, 212, 212, 212, 213, 213, 214, 214, 214, 215, 215, 215, 216, 216, 217,   // Pages 528-543
+    217, 217, 218, 218, 218, 219, 219, 219, 220, 221, 221, 221, 221, 222, 222, 223,   // Pages 544-559
+    223, 224, 224, 225, 225, 226, 226, 226, 227, 227, 227, 228, 228, 228, 229, 229,   // Pages 560-575
+    230, 230, 231, 231, 231, 232, 232, 232, 233, 233, 234, 234, 235, 235, 236, 236,   // Pages 576-591
+    236, 237, 237, 238, 238, 238, 239, 239, 239, 239, 239, 239,   // Pages 592-603
+};
+
 #endif // QURAN_METADATA_H
@@ -19,6 +19,8 @@
 #include "SkSurface.h"
 #include "SkPath.h"
 #include "SkPathBuilder.h"
+#include "SkBitmap.h"
+#include "SkImage.h"
 
 #pragma GCC diagnostic pop
 
@@ -35,16 +37,38 @@
 
 #pragma GCC diagnostic pop
 
+#include "glyph_rasterizer.h"
+#include "glyph_sdf.h"
 #include "hb_skia_canvas.h"
+#include "lru_cache.h"
 #include "quran.h"
 #include "quran_metadata.h"
+#include "quran_search.h"
+#include "quran_text_index.h"
+#include "tajweed_classifier.h"
 
 #include <string>
 #include <sstream>
 #include <regex>
+#include <climits>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define QURAN_FILL_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define QURAN_FILL_NEON 1
+#endif
+
 namespace {
 
 enum class LineType {
@@ -62,6 +86,202 @@ struct QuranLine {
     std::string text;
     LineType line_type = LineType::Line;
     JustType just_type = JustType::just;
+    std::vector<uint8_t> tajweed;   // TajweedClass per byte of text, for fonts without embedded tajweed
+};
+
+// Page geometry shared by drawPage and the page metrics API
+struct PageLayout {
+    int char_height;
+    int inter_line;
+    int y_start;
+    int x_padding;
+    int x_start;
+    double scale;       // Device pixels per font unit
+    double pageWidth;   // Full line width in font units
+};
+
+// Position of one line: origin is the right edge of the line on its baseline
+struct LineBox {
+    double lineWidth;   // Font units
+    double originX;
+    double baseline;
+};
+
+// Glyph id of the space in the DigitalKhatt fonts
+constexpr hb_codepoint_t spaceCodePoint = 3;
+
+// HarfBuzz buffer shaped with the renderer's font (RTL Arabic)
+struct ShapedText {
+    hb_buffer_t* buffer = nullptr;
+    unsigned count = 0;
+    hb_glyph_info_t* info = nullptr;
+    hb_glyph_position_t* pos = nullptr;
+    const uint8_t* tajweedClasses = nullptr;    // Classifier output indexed by cluster, if any
+    
+    ShapedText() = default;
+    ShapedText(const ShapedText&) = delete;
+    ShapedText& operator=(const ShapedText&) = delete;
+    ~ShapedText() {
+        if (buffer) hb_buffer_destroy(buffer);
+    }
+};
+
+// Identifies a shaping result of the renderer's font (the font is per renderer)
+struct ShapeKey {
+    std::string text;
+    double justifyWidth;        // Font units, 0 = not justified
+    bool tajweed;
+    
+    bool operator==(const ShapeKey& other) const {
+        return justifyWidth == other.justifyWidth && tajweed == other.tajweed && text == other.text;
+    }
+};
+
+struct ShapeKeyHash {
+    size_t operator()(const ShapeKey& key) const {
+        size_t h = std::hash<std::string>()(key.text);
+        h ^= std::hash<double>()(key.justifyWidth) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+        return h ^ (key.tajweed ? 0x51ed270b27d4f1a3ULL : 0);
+    }
+};
+
+// Identifies a shaped page line: the line (owned by the renderer's pages) and
+// its justification width bucket, 0 = not justified
+struct LineShapeKey {
+    const QuranLine* line;
+    int bucket;
+    bool tajweed;
+    
+    bool operator==(const LineShapeKey& other) const {
+        return line == other.line && bucket == other.bucket && tajweed == other.tajweed;
+    }
+};
+
+struct LineShapeKeyHash {
+    size_t operator()(const LineShapeKey& key) const {
+        size_t h = std::hash<const void*>()(key.line);
+        h ^= std::hash<int>()(key.bucket) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+        return h ^ (key.tajweed ? 0x51ed270b27d4f1a3ULL : 0);
+    }
+};
+
+// Identifies a glyph outline in device space: the glyph instance, the canvas
+// scale, the curve tolerance and the subpixel offset of the glyph origin
+struct OutlineKey {
+    const hb_font_t* font;
+    uint64_t instance;          // glyphInstanceKey
+    float scaleX;
+    float scaleY;
+    float tolerance;            // Device pixels, 0 = curves kept
+    float offsetX;              // Pixels, quantized
+    float offsetY;
+    
+    bool operator==(const OutlineKey& other) const {
+        return font == other.font && instance == other.instance &&
+               scaleX == other.scaleX && scaleY == other.scaleY && tolerance == other.tolerance &&
+               offsetX == other.offsetX && offsetY == other.offsetY;
+    }
+};
+
+struct OutlineKeyHash {
+    size_t operator()(const OutlineKey& key) const {
+        size_t h = std::hash<const void*>()(key.font);
+        auto mix = [&h](size_t value) { h ^= value + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2); };
+        mix(std::hash<uint64_t>()(key.instance));
+        mix(std::hash<float>()(key.scaleX));
+        mix(std::hash<float>()(key.scaleY));
+        mix(std::hash<float>()(key.tolerance));
+        mix(std::hash<float>()(key.offsetX));
+        mix(std::hash<float>()(key.offsetY));
+        return h;
+    }
+};
+
+// Portrait and landscape widths (px) of common phones and tablets, whose
+// justification buckets quran_renderer_prepare_justification fills by default
+constexpr int kCommonPageWidths[] = {
+    720, 750, 828, 1080, 1125, 1170, 1179, 1242, 1284, 1290, 1440,
+    1536, 1600, 1620, 1668, 1800, 2048, 2160, 2388, 2560,
+};
+
+// Approximate memory of a shaped run of `length` text bytes. The buffer's
+// info and position arrays are counted at their allocated size, which grows
+// by half again plus 32 entries at a time, not at the glyph count.
+inline size_t shapedTextBytes(const ShapedText& shaped, size_t length) {
+    const size_t allocated = shaped.buffer ? std::max(shaped.buffer->allocated, shaped.count) : shaped.count;
+    return sizeof(ShapedText) + sizeof(hb_buffer_t) + 2 * length +
+           allocated * (sizeof(hb_glyph_info_t) + sizeof(hb_glyph_position_t));
+}
+
+// How drawLine places a shaped line inside its line box (font units)
+struct LineFit {
+    double ratio = 1.0;         // Shrink factor for lines wider than the box
+    double startX = 0;          // Pen start: negative pad for centered lines
+    bool stretchSpaces = false; // Spaces take spaceWidth instead of their advance
+    double spaceWidth = 0;
+    
+    double advance(const ShapedText& shaped, unsigned i) const {
+        if (stretchSpaces && shaped.info[i].codepoint == spaceCodePoint) {
+            return spaceWidth;
+        }
+        return shaped.pos[i].x_advance;
+    }
+};
+
+// Byte range and pen extents (font units, relative to the line origin) of a HarfBuzz cluster
+struct ClusterExtent {
+    uint32_t byteStart;
+    uint32_t byteEnd;
+    double left;
+    double right;
+};
+
+// Walks glyphs in drawing order and merges them per cluster; results are in byte order
+void collectClusters(const ShapedText& shaped, const LineFit& fit, uint32_t textLength,
+                     std::vector<ClusterExtent>* out) {
+    std::vector<ClusterExtent> glyphs;
+    glyphs.reserve(shaped.count);
+    
+    double pen = fit.startX;
+    for (int i = shaped.count - 1; i >= 0; i--) {
+        double right = pen;
+        pen -= fit.advance(shaped, i);
+        glyphs.push_back({shaped.info[i].cluster, 0, pen, right});
+    }
+    
+    std::stable_sort(glyphs.begin(), glyphs.end(), [](const ClusterExtent& a, const ClusterExtent& b) {
+        return a.byteStart < b.byteStart;
+    });
+    
+    size_t first = out->size();
+    for (const ClusterExtent& glyph : glyphs) {
+        if (out->size() > first && out->back().byteStart == glyph.byteStart) {
+            out->back().left = std::min(out->back().left, glyph.left);
+            out->back().right = std::max(out->back().right, glyph.right);
+        } else {
+            out->push_back(glyph);
+        }
+    }
+    
+    for (size_t k = first; k < out->size(); k++) {
+        (*out)[k].byteEnd = (k + 1 < out->size()) ? (*out)[k + 1].byteStart : textLength;
+    }
+}
+
+// Part of a mushaf line shown in an ayah share image, with its ink box
+// (device pixels: x in page coordinates, y relative to the baseline, down positive)
+struct AyahImageLine {
+    int pageIndex;
+    int lineIndex;
+    uint32_t byteStart;         // Ayah text within the line text
+    uint32_t byteEnd;
+    std::shared_ptr<const ShapedText> shaped;
+    LineFit fit;
+    LineBox box;
+    double left;
+    double top;
+    double right;
+    double bottom;
 };
 
 // Calculate relative luminance of a color (0.0 = black, 1.0 = white)
@@ -78,13 +298,227 @@ inline bool isDarkBackground(uint32_t backgroundColor) {
     return calculateLuminance(r, g, b) < 0.5f;
 }
 
-// Get appropriate text color for background
-inline hb_color_t getTextColorForBackground(uint32_t backgroundColor) {
-    return isDarkBackground(backgroundColor) 
-        ? HB_COLOR(255, 255, 255, 255)  // White text for dark backgrounds
-        : HB_COLOR(0, 0, 0, 255);        // Black text for light backgrounds
+
+// Default colors of the TajweedClass values (0xRRGGBB), after the Dar
+// al-Maarifah tajweed mushaf
+constexpr uint32_t kTajweedClassColors[static_cast<int>(TajweedClass::Count)] = {
+    0x000000,   // None (unused, the text color applies)
+    0x169777,   // Green: ghunna, idgham, ikhfa, iqlab
+    0x0E3C8C,   // Tafkim: dark blue
+    0xA0A0A0,   // LGray: silent letters
+    0x2DA7DD,   // LKalkala: light blue
+    0xD4A017,   // Red1: permissible madd
+    0xF57C00,   // Red2: munfasil
+    0xE53935,   // Red3: muttasil
+    0x8B0000,   // Red4: lazim
+};
+
+// QuranTajweedColor is TajweedClass without None
+static_assert(QURAN_TAJWEED_COLOR_COUNT == static_cast<int>(TajweedClass::Count) - 1,
+              "QuranTajweedColor and TajweedClass must list the same categories");
+
+// 0xRRGGBBAA (the API's color format) to hb_color_t
+inline hb_color_t hbColorFromRgba(uint32_t rgba) {
+    return HB_COLOR((rgba >> 8) & 0xFF, (rgba >> 16) & 0xFF, (rgba >> 24) & 0xFF, rgba & 0xFF);
+}
+
+// White fills of the ayah glyphs, shown as the page background
+inline bool isNearWhite(hb_color_t color, int tolerance = 10) {
+    return hb_color_get_red(color) >= 255 - tolerance &&
+           hb_color_get_green(color) >= 255 - tolerance &&
+           hb_color_get_blue(color) >= 255 - tolerance;
+}
+
+// Every color a render paints, resolved once per background and theme.
+// Paint callbacks and paintGlyphs only index into it.
+struct ColorTable {
+    uint32_t backgroundColor = 0;           // Key (0xRRGGBBAA)
+    uint32_t textColor = 0;                 // Key: caller's text color, 0 = theme/automatic
+    hb_color_t background = 0;
+    hb_color_t text = 0;
+    hb_color_t tajweed[static_cast<int>(TajweedClass::Count)] = {};
+    bool themedTajweed = false;             // Theme overrides any tajweed color
+    std::vector<hb_color_t> palette;        // CPAL palette 0 of the Quran font
+    std::vector<hb_color_t> headerPalette;  // CPAL palette 0 of the surah header font
+    
+    // Embedded (GPOS) tajweed colors met so far and their themed color
+    static constexpr int kMaxEmbedded = 16;
+    uint32_t embeddedRgb[kMaxEmbedded] = {};
+    hb_color_t embeddedColor[kMaxEmbedded] = {};
+    int embeddedCount = 0;
+};
+
+// Font palette with white fills replaced by the background
+inline void resolvePalette(hb_face_t* face, hb_color_t background, std::vector<hb_color_t>* palette) {
+    palette->clear();
+    if (!face) return;
+    unsigned count = hb_ot_color_palette_get_colors(face, 0, 0, nullptr, nullptr);
+    palette->resize(count);
+    hb_ot_color_palette_get_colors(face, 0, 0, &count, palette->data());
+    palette->resize(count);
+    for (hb_color_t& color : *palette) {
+        if (isNearWhite(color)) color = background;
+    }
+}
+
+// Points a paint context at the resolved colors of the Quran font
+inline void setContextColors(skia_context_t* context, const ColorTable& colors) {
+    context->foreground = colors.text;
+    context->palette = colors.palette.data();
+    context->palette_size = static_cast<unsigned>(colors.palette.size());
+}
+
+// Cache key of a glyph instance: glyph and kashida variation coordinates (2.14)
+inline uint64_t glyphInstanceKey(hb_codepoint_t glyph, int coord0, int coord1) {
+    return (static_cast<uint64_t>(glyph) << 40) |
+           (static_cast<uint64_t>((coord0 + 0x80000) & 0xFFFFF) << 20) |
+           static_cast<uint64_t>((coord1 + 0x80000) & 0xFFFFF);
+}
+
+// Fills a rectangle of a 32-bit pixel buffer with one pixel value (already in
+// the buffer's byte order), four pixels per store
+void fillPixels(void* pixels, int stride, const SkIRect& rect, uint32_t pixel) {
+    const int width = rect.width();
+    for (int y = rect.top(); y < rect.bottom(); y++) {
+        uint32_t* row = reinterpret_cast<uint32_t*>(static_cast<uint8_t*>(pixels) +
+                                                    static_cast<size_t>(y) * stride) + rect.left();
+        int x = 0;
+#if defined(QURAN_FILL_SSE2)
+        const __m128i value = _mm_set1_epi32(static_cast<int>(pixel));
+        for (; x + 4 <= width; x += 4) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(row + x), value);
+        }
+#elif defined(QURAN_FILL_NEON)
+        const uint32x4_t value = vdupq_n_u32(pixel);
+        for (; x + 4 <= width; x += 4) {
+            vst1q_u32(row + x, value);
+        }
+#endif
+        for (; x < width; x++) {
+            row[x] = pixel;
+        }
+    }
+}
+
+// Opaque background color (0xRRGGBBAA) as a pixel of the buffer format
+uint32_t backgroundPixel(uint32_t background, QuranPixelFormat format) {
+    const uint8_t r = (background >> 24) & 0xFF;
+    const uint8_t g = (background >> 16) & 0xFF;
+    const uint8_t b = (background >> 8) & 0xFF;
+    const uint8_t a = background & 0xFF;
+    const uint8_t bytes[4] = {
+        format == QURAN_PIXEL_FORMAT_BGRA8888 ? b : r, g,
+        format == QURAN_PIXEL_FORMAT_BGRA8888 ? r : b, a
+    };
+    uint32_t pixel;
+    memcpy(&pixel, bytes, sizeof(pixel));
+    return pixel;
 }
 
+// How the COLR layers of a glyph are painted
+enum class ColrDetail {
+    Full,           // Every layer, as the font describes it
+    Flattened,      // One fill of the outline in the glyph's (tajweed) color
+    Mono,           // One fill of the outline in the text color
+};
+
+// Fill settings of a render quality level
+struct RenderSettings {
+    bool antiAlias;
+    float flattenTolerance;     // Device pixels, 0 = Skia flattens the curves
+    ColrDetail colr;
+    int subpixelBins;           // Glyph origins snap to 1/bins pixel, 0 = unsnapped
+    bool glyphRasterizer;       // Anti-aliased single fills through GlyphRasterizer, not Skia's path filler
+    bool distanceFields;        // Single fills sampled from cached glyph SDFs
+    bool deviceOutlines;        // Path fills from outlines cached in device space
+};
+
+inline RenderSettings renderSettings(QuranRenderQuality quality) {
+    switch (quality) {
+        case QURAN_QUALITY_LOW:
+            return {false, 0.5f, ColrDetail::Flattened, 1, false, false, true};
+        case QURAN_QUALITY_MEDIUM:
+            return {true, 0.2f, ColrDetail::Flattened, 4, true, false, true};
+        case QURAN_QUALITY_ZOOM:
+            return {true, 0.0f, ColrDetail::Flattened, 0, false, true, false};
+        case QURAN_QUALITY_DEFAULT:
+        case QURAN_QUALITY_HIGH:
+        default:
+            return {true, 0.0f, ColrDetail::Full, 0, false, false, true};
+    }
+}
+
+// Draft passes: the cheapest fill, every glyph in the text color
+constexpr RenderSettings kDraftSettings = {false, 0.5f, ColrDetail::Mono, 1, false, false, true};
+
+// Runs render passes of a renderer in order on one background thread
+class RenderQueue {
+public:
+    RenderQueue() : worker([this] { run(); }) {}
+    
+    RenderQueue(const RenderQueue&) = delete;
+    RenderQueue& operator=(const RenderQueue&) = delete;
+    
+    ~RenderQueue() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+            jobs.clear();
+        }
+        wake.notify_all();
+        worker.join();
+    }
+    
+    void push(std::function<void()> job) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            jobs.push_back(std::move(job));
+        }
+        wake.notify_one();
+    }
+    
+    // Drops the passes not started yet and waits for the running one
+    void cancel() {
+        std::unique_lock<std::mutex> lock(mutex);
+        jobs.clear();
+        idle.wait(lock, [this] { return !running; });
+    }
+    
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        idle.wait(lock, [this] { return jobs.empty() && !running; });
+    }
+    
+private:
+    void run() {
+        for (;;) {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [this] { return stopping || !jobs.empty(); });
+                if (stopping) return;
+                job = std::move(jobs.front());
+                jobs.pop_front();
+                running = true;
+            }
+            job();
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                running = false;
+            }
+            idle.notify_all();
+        }
+    }
+    
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable idle;
+    std::deque<std::function<void()>> jobs;
+    bool running = false;
+    bool stopping = false;
+    std::thread worker;         // Last: starts once the members above exist
+};
+
 } // anonymous namespace
 
 struct QuranRendererImpl {
@@ -103,10 +537,72 @@ struct QuranRendererImpl {
     std::unordered_map<int, int> surahNumbers; // Maps page*15+line to surah number
     
     bool tajweed = true;
+    RenderSettings render = renderSettings(QURAN_QUALITY_DEFAULT);
     unsigned int tajweedcolorindex = 0xFFFF;
+    
+    QuranTheme theme{};                     // Zero entries = default colors
+    unsigned themeGeneration = 0;           // Bumped by setTheme; cached line images compare it
+    ColorTable colors;                      // Current resolved colors
+    bool colorsResolved = false;
     hb_feature_t features[1];
     int coords[2];
     
+    // Glyph extents (font units) per glyph and kashida variation instance
+    std::unordered_map<uint64_t, hb_glyph_extents_t> glyphExtentsCache;
+    
+    // Scratch space of fillGlyphCoverage and fillGlyphSdf, reused across glyphs
+    GlyphRasterizer rasterizer;
+    std::vector<float> glyphSegments;
+    std::vector<uint8_t> glyphMask;
+    
+    // Distance fields of the Quran font's glyph instances (QURAN_QUALITY_ZOOM)
+    static constexpr size_t kSdfCacheBudget = 16 * 1024 * 1024;
+    LruCache<uint64_t, GlyphSdf> sdfCache{kSdfCacheBudget};
+    
+    // Shaped runs of short strings drawn or measured repeatedly (surah names,
+    // basmala, juz labels) through draw_text/measure_text
+    static constexpr size_t kShapeCacheBudget = 2 * 1024 * 1024;
+    static constexpr size_t kShapeCacheMaxText = 1024;
+    LruCache<ShapeKey, ShapedText, ShapeKeyHash> shapeCache{kShapeCacheBudget};
+    
+    // Shaped page lines. Kashida justification is shaped at the line width
+    // rounded down to a bucket (1/8 em) and fitLine stretches the spaces over
+    // the rest, so the many device widths whose lines differ by a few font
+    // units share one result. A line takes about 6.5 KB, so the budget holds
+    // some 160 pages of one bucket; prepareLines fills at most half of it.
+    static constexpr size_t kLineCacheBudget = 16 * 1024 * 1024;
+    static constexpr size_t kPrepareBudget = kLineCacheBudget / 2;
+    static constexpr int kJustifyBucketsPerEm = 8;
+    LruCache<LineShapeKey, ShapedText, LineShapeKeyHash> lineShapeCache{kLineCacheBudget};
+    
+    // Glyph outlines transformed to device pixels. Zoom stays put for most of
+    // a reading session, so after the first page nearly every glyph is a hit
+    // and skips the outline walk and Skia's per-verb transform.
+    static constexpr size_t kOutlineCacheBudget = 8 * 1024 * 1024;
+    static constexpr int kOutlineSubpixelBins = 16;     // Levels with unsnapped origins
+    LruCache<OutlineKey, SkPath, OutlineKeyHash> outlineCache{kOutlineCacheBudget};
+    
+    // Buffer and ink of the last QURAN_CLEAR_DIRTY draw, which the next one
+    // into the same buffer refills with the background
+    struct Frame {
+        const void* pixels = nullptr;   // nullptr = nothing recorded
+        int width = 0;
+        int height = 0;
+        int stride = 0;
+        QuranPixelFormat format = QURAN_PIXEL_FORMAT_RGBA8888;
+        uint32_t background = 0;
+        SkIRect ink = SkIRect::MakeEmpty();     // Device pixels
+    };
+    Frame lastFrame;
+    Frame frame;                // Draw being recorded
+    bool recordingInk = false;  // paintGlyphs and drawSurahHeader add to frame.ink
+    
+    // Second instance that draws the other half of a spread on its own thread
+    std::unique_ptr<QuranRendererImpl> spreadWorker;
+    
+    // Background thread of the async drawing API, started on first use
+    std::unique_ptr<RenderQueue> renderQueue;
+    
     // Font data kept alive
     const uint8_t* fontDataPtr = nullptr;
     const uint8_t* surahHeaderFontData = nullptr;
@@ -134,6 +630,9 @@ struct QuranRendererImpl {
     }
     
     ~QuranRendererImpl() {
+        // Finish the running pass before the fonts go away
+        renderQueue.reset();
+        
         if (font) hb_font_destroy(font);
         if (face) hb_face_destroy(face);
         if (surah_header_font) hb_font_destroy(surah_header_font);
@@ -179,13 +678,130 @@ struct QuranRendererImpl {
             // Font has embedded tajweed support
             tajweedcolorindex = 152;
         }
-        // Otherwise keep default 0xFFFF (disabled, will fall back to base_codepoint check)
+        // Otherwise keep default 0xFFFF and color the text with the rule-based classifier
+        if (tajweedcolorindex == 0xFFFF) {
+            classifyTajweed();
+        }
         
         // Load surah header font
         loadSurahHeaderFont();
         
         return true;
     }
+    // Shares the immutable faces and parsed text of source; the fonts, which
+    // carry kashida variation coords while painting, are private. Everything
+    // parseQuranText sets up is copied, the Fatiha line widths included.
+    void initializeFrom(const QuranRendererImpl& source) {
+        fontDataPtr = source.fontDataPtr;
+        face = hb_face_reference(source.face);
+        pages = source.pages;
+        lineWidths = source.lineWidths;
+        surahNumbers = source.surahNumbers;
+        ar_language = source.ar_language;
+        upem = source.upem;
+        tajweedcolorindex = source.tajweedcolorindex;
+        theme = source.theme;
+        themeGeneration = source.themeGeneration;
+        
+        font = hb_font_create(face);
+        hb_font_set_scale(font, upem, upem);
+        
+        draw_funcs = hb_draw_funcs_reference(source.draw_funcs);
+        paint_funcs = hb_paint_funcs_reference(source.paint_funcs);
+        
+        if (source.surah_header_face) {
+            surah_header_face = hb_face_reference(source.surah_header_face);
+            surah_header_upem = source.surah_header_upem;
+            surah_header_font = hb_font_create(surah_header_face);
+            hb_font_set_scale(surah_header_font, surah_header_upem, surah_header_upem);
+        }
+    }
+    
+    QuranRendererImpl* getSpreadWorker() {
+        if (!spreadWorker) {
+            spreadWorker.reset(new QuranRendererImpl());
+            spreadWorker->initializeFrom(*this);
+        }
+        return spreadWorker.get();
+    }
+    
+    void setTheme(const QuranTheme* newTheme) {
+        theme = newTheme ? *newTheme : QuranTheme{};
+        themeGeneration++;
+        colorsResolved = false;
+        if (spreadWorker) {
+            spreadWorker->setTheme(newTheme);
+        }
+    }
+    
+    // Resolves the colors of a render on backgroundColor; textColor overrides
+    // the theme's text color (0 = none). Reused until either changes.
+    const ColorTable& resolveColors(uint32_t backgroundColor, uint32_t textColor = 0) {
+        if (colorsResolved && colors.backgroundColor == backgroundColor && colors.textColor == textColor) {
+            return colors;
+        }
+        
+        colors.backgroundColor = backgroundColor;
+        colors.textColor = textColor;
+        colors.background = hbColorFromRgba(backgroundColor);
+        
+        // Text is always opaque
+        uint32_t text = textColor != 0 ? textColor
+                      : theme.textColor != 0 ? theme.textColor
+                      : (isDarkBackground(backgroundColor) ? 0xFFFFFFFF : 0x000000FF);
+        colors.text = hbColorFromRgba(text | 0xFF);
+        
+        colors.themedTajweed = false;
+        colors.tajweed[0] = colors.text;
+        for (int i = 1; i < static_cast<int>(TajweedClass::Count); i++) {
+            uint32_t themed = theme.tajweedColors[i - 1];
+            colors.themedTajweed |= themed != 0;
+            colors.tajweed[i] = themed != 0 ? hbColorFromRgba(themed)
+                                            : hbColorFromRgba((kTajweedClassColors[i] << 8) | 0xFF);
+        }
+        
+        resolvePalette(face, colors.background, &colors.palette);
+        resolvePalette(surah_header_face, colors.background, &colors.headerPalette);
+        colors.embeddedCount = 0;
+        colorsResolved = true;
+        return colors;
+    }
+    
+    // Color of a tajweed lookup of the font (RGB in the top bytes of base_codepoint).
+    // Under a theme with tajweed colors it becomes the themed color of the nearest
+    // default category; the few distinct font colors are matched once each.
+    hb_color_t embeddedTajweedColor(uint32_t baseCodepoint) {
+        uint32_t rgb = baseCodepoint >> 8;
+        if (!colors.themedTajweed) {
+            return hbColorFromRgba((rgb << 8) | 0xFF);
+        }
+        
+        for (int i = 0; i < colors.embeddedCount; i++) {
+            if (colors.embeddedRgb[i] == rgb) return colors.embeddedColor[i];
+        }
+        
+        int nearest = 1;
+        int nearestDistance = INT_MAX;
+        for (int i = 1; i < static_cast<int>(TajweedClass::Count); i++) {
+            int dr = static_cast<int>((rgb >> 16) & 0xFF) - static_cast<int>((kTajweedClassColors[i] >> 16) & 0xFF);
+            int dg = static_cast<int>((rgb >> 8) & 0xFF) - static_cast<int>((kTajweedClassColors[i] >> 8) & 0xFF);
+            int db = static_cast<int>(rgb & 0xFF) - static_cast<int>(kTajweedClassColors[i] & 0xFF);
+            int distance = dr * dr + dg * dg + db * db;
+            if (distance < nearestDistance) {
+                nearestDistance = distance;
+                nearest = i;
+            }
+        }
+        
+        hb_color_t color = colors.tajweed[nearest];
+        if (colors.embeddedCount < ColorTable::kMaxEmbedded) {
+            colors.embeddedRgb[colors.embeddedCount] = rgb;
+            colors.embeddedColor[colors.embeddedCount] = color;
+            colors.embeddedCount++;
+        }
+        return color;
+    }
+    
     bool loadSurahHeaderFont() {
         // Load from assets directory (desktop/iOS)
         FILE* fontFile = fopen("assets/QCF_SurahHeader_COLOR-Regular.ttf", "rb");
@@ -232,6 +848,10 @@ struct QuranRendererImpl {
         surah_header_upem = hb_face_get_upem(surah_header_face);
         surah_header_font = hb_font_create(surah_header_face);
         hb_font_set_scale(surah_header_font, surah_header_upem, surah_header_upem);
+        colorsResolved = false;
+        
+        // The spread worker copied the previous header font state
+        spreadWorker.reset();
         
         return true;
     }
@@ -277,6 +897,10 @@ struct QuranRendererImpl {
         double scale_y = height / glyph_height;
         double scale = std::min(scale_x, scale_y) * 0.9; // Use 90% to add some padding
         
+        if (recordingInk) {
+            recordInk(canvas, SkRect::MakeXYWH(x, y, width, height));
+        }
+        
         // Calculate center position
         float centerX = x + width / 2.0f;
         float centerY = y + height / 2.0f;
@@ -293,9 +917,23 @@ struct QuranRendererImpl {
         // Center the glyph
         canvas->translate(-glyph_width / 2.0, 0);
         
+        if (render.colr != ColrDetail::Full) {
+            setGlyphFill(context);
+            drawGlyphOutline(context, surah_header_font, glyph, context->foreground);
+            canvas->restore();
+            return;
+        }
+        
         // Render the glyph using the surah header font
         // The font is a COLOR font, so it will render with embedded colors
+        // The header font has its own palette
+        const hb_color_t* fontPalette = context->palette;
+        unsigned int fontPaletteSize = context->palette_size;
+        context->palette = colors.headerPalette.data();
+        context->palette_size = static_cast<unsigned>(colors.headerPalette.size());
         hb_font_paint_glyph(surah_header_font, glyph, paint_funcs, context, 0, context->foreground);
+        context->palette = fontPalette;
+        context->palette_size = fontPaletteSize;
         
         // Restore canvas state
         canvas->restore();
@@ -328,19 +966,19 @@ struct QuranRendererImpl {
         
         // Outer fill paint
         SkPaint outerPaint;
-        outerPaint.setAntiAlias(true);
+        outerPaint.setAntiAlias(render.antiAlias);
         outerPaint.setStyle(SkPaint::kFill_Style);
         outerPaint.setColor(outerColor);
         
         // Inner fill paint (white background for the text)
         SkPaint innerPaint;
-        innerPaint.setAntiAlias(true);
+        innerPaint.setAntiAlias(render.antiAlias);
         innerPaint.setStyle(SkPaint::kFill_Style);
         innerPaint.setColor(innerColor);
         
         // Stroke paint
         SkPaint strokePaint;
-        strokePaint.setAntiAlias(true);
+        strokePaint.setAntiAlias(render.antiAlias);
         strokePaint.setStyle(SkPaint::kStroke_Style);
         strokePaint.setStrokeWidth(height * 0.01f);
         strokePaint.setColor(strokeColor);
@@ -497,180 +1135,624 @@ struct QuranRendererImpl {
         }
     }
     
-    void drawLine(QuranLine& lineText, skia_context_t* context, double lineWidth, bool justify, double scale, hb_color_t defaultTextColor = HB_COLOR(0, 0, 0, 255), bool disableTajweed = false) {
-        unsigned count = 0;
-        hb_glyph_info_t* glyph_info = nullptr;
-        hb_glyph_position_t* glyph_pos = nullptr;
-        const int spaceCodePoint = 3;
-        int currentLineWidth;
-        double spaceWidth;
+    // Precomputes the tajweed classes of every line (Sura lines are never
+    // colored). Mushaf lines and pages break mid-ayah and the rules look at
+    // the next letter, so the lines between two surah names are classified
+    // as one newline-joined text and the classes sliced back per line.
+    void classifyTajweed() {
+        std::string text;
+        std::vector<QuranLine*> run;
+        std::vector<uint8_t> classes;
         
-        auto canvas = context->canvas;
+        auto flush = [&] {
+            if (run.empty()) return;
+            quranClassifyTajweed(text.data(), static_cast<uint32_t>(text.size()), &classes);
+            size_t offset = 0;
+            for (QuranLine* line : run) {
+                line->tajweed.assign(classes.begin() + offset, classes.begin() + offset + line->text.size());
+                offset += line->text.size() + 1;
+            }
+            text.clear();
+            run.clear();
+        };
         
-        hb_buffer_t* buffer = hb_buffer_create();
-        hb_buffer_set_direction(buffer, HB_DIRECTION_RTL);
-        hb_buffer_set_script(buffer, HB_SCRIPT_ARABIC);
-        hb_buffer_set_language(buffer, ar_language);
+        for (auto& page : pages) {
+            for (auto& line : page) {
+                if (line.line_type == LineType::Sura) {
+                    flush();
+                    continue;
+                }
+                if (!run.empty()) text += '\n';
+                text += line.text;
+                run.push_back(&line);
+            }
+        }
+        flush();
+    }
+    
+    void shapeText(const char* text, size_t length, double justifyWidth, bool useTajweed, ShapedText* shaped) {
+        shaped->buffer = hb_buffer_create();
+        hb_buffer_set_direction(shaped->buffer, HB_DIRECTION_RTL);
+        hb_buffer_set_script(shaped->buffer, HB_SCRIPT_ARABIC);
+        hb_buffer_set_language(shaped->buffer, ar_language);
         
-        hb_buffer_add_utf8(buffer, lineText.text.c_str(), lineText.text.size(), 0, lineText.text.size());
+        hb_buffer_add_utf8(shaped->buffer, text, length, 0, length);
         
-        if (justify && lineText.just_type == JustType::just) {
-            hb_buffer_set_justify(buffer, lineWidth);
+        if (justifyWidth > 0) {
+            hb_buffer_set_justify(shaped->buffer, justifyWidth);
         }
         
-        // Disable tajweed for surah name lines - they should be plain black text
-        bool useTajweed = tajweed && !disableTajweed;
         features[0].value = useTajweed ? 1 : 0;
-        hb_shape(font, buffer, features, 1);
+        hb_shape(font, shaped->buffer, features, 1);
+        
+        shaped->info = hb_buffer_get_glyph_infos(shaped->buffer, &shaped->count);
+        shaped->pos = hb_buffer_get_glyph_positions(shaped->buffer, &shaped->count);
+    }
+    
+    // Justification bucket of a line width (font units), 0 = not justified
+    int justifyBucket(const QuranLine& lineText, double lineWidth, bool justify) const {
+        if (!justify || lineText.just_type != JustType::just) return 0;
+        return std::max(1, static_cast<int>(lineWidth * kJustifyBucketsPerEm / upem));
+    }
+    
+    // A page line shaped for lineWidth through the line cache (see lineShapeCache)
+    std::shared_ptr<const ShapedText> shapeLine(const QuranLine& lineText, double lineWidth, bool justify, bool useTajweed) {
+        LineShapeKey key{&lineText, justifyBucket(lineText, lineWidth, justify), useTajweed};
+        if (auto cached = lineShapeCache.get(key)) {
+            return cached;
+        }
+        
+        auto shaped = std::make_shared<ShapedText>();
+        double justifyWidth = static_cast<double>(key.bucket) * upem / kJustifyBucketsPerEm;
+        shapeText(lineText.text.c_str(), lineText.text.size(), justifyWidth, useTajweed, shaped.get());
+        if (useTajweed && !lineText.tajweed.empty()) {
+            shaped->tajweedClasses = lineText.tajweed.data();
+        }
+        lineShapeCache.put(key, shaped, shapedTextBytes(*shaped, lineText.text.size()));
+        return shaped;
+    }
+    
+    // Shapes the lines of pages [firstPage, lastPage] for each page width (px)
+    // into the line cache, page by page so the nearest pages come first.
+    // Stops once the lines it shaped reach kPrepareBudget, past which they
+    // would only evict each other. Returns the number of lines shaped.
+    int prepareLines(int firstPage, int lastPage, const int* widths, size_t widthCount,
+                     bool justify, bool useTajweed) {
+        int shapedLines = 0;
+        size_t shapedBytes = 0;
+        for (int pageIndex = firstPage; pageIndex <= lastPage; pageIndex++) {
+            const auto& pageText = pages[pageIndex];
+            for (size_t w = 0; w < widthCount; w++) {
+                const PageLayout layout = computePageLayout(widths[w], 0, pageIndex);
+                for (size_t lineIndex = 0; lineIndex < pageText.size(); lineIndex++) {
+                    const QuranLine& lineText = pageText[lineIndex];
+                    if (lineText.line_type == LineType::Sura) continue;
+                    
+                    // Widths falling into an already prepared bucket cost only the lookups
+                    const LineBox box = computeLineBox(layout, pageIndex, static_cast<int>(lineIndex));
+                    LineShapeKey key{&lineText, justifyBucket(lineText, box.lineWidth, justify), useTajweed};
+                    if (lineShapeCache.get(key)) continue;
+                    auto shaped = shapeLine(lineText, box.lineWidth, justify, useTajweed);
+                    shapedBytes += shapedTextBytes(*shaped, lineText.text.size());
+                    shapedLines++;
+                    if (shapedBytes >= kPrepareBudget) return shapedLines;
+                }
+            }
+        }
+        return shapedLines;
+    }
+    
+    // shapeText through the shaped-string cache; long texts bypass it
+    std::shared_ptr<const ShapedText> shapeTextCached(const char* text, size_t length,
+                                                      double justifyWidth, bool useTajweed) {
+        if (length > kShapeCacheMaxText) {
+            auto shaped = std::make_shared<ShapedText>();
+            shapeText(text, length, justifyWidth, useTajweed, shaped.get());
+            return shaped;
+        }
         
-        glyph_info = hb_buffer_get_glyph_infos(buffer, &count);
-        glyph_pos = hb_buffer_get_glyph_positions(buffer, &count);
+        ShapeKey key{std::string(text, length), justifyWidth, useTajweed};
+        if (auto cached = shapeCache.get(key)) {
+            return cached;
+        }
         
+        auto shaped = std::make_shared<ShapedText>();
+        shapeText(text, length, justifyWidth, useTajweed, shaped.get());
+        shapeCache.put(key, shaped, shapedTextBytes(*shaped, length));
+        return shaped;
+    }
+    
+    // Sum of advances in font units (what measure_text reports before scaling)
+    int advanceWidth(const char* text, size_t length, bool useTajweed) {
+        ShapedText shaped;
+        shapeText(text, length, 0, useTajweed, &shaped);
+        int total = 0;
+        for (unsigned i = 0; i < shaped.count; i++) {
+            total += shaped.pos[i].x_advance;
+        }
+        return total;
+    }
+    
+    // Width of an inter-word space in font units, as draw_wrapped_text measures it
+    int wordSpaceWidth(bool useTajweed) {
+        int withSpace = advanceWidth("ا ب", strlen("ا ب"), useTajweed);
+        int withoutSpace = advanceWidth("اب", strlen("اب"), useTajweed);
+        int width = withSpace - withoutSpace;
+        return width > 0 ? width : static_cast<int>(upem / 4);
+    }
+    
+    LineFit fitLine(const QuranLine& lineText, const ShapedText& shaped, double lineWidth) const {
+        LineFit fit;
         int textWidth = 0;
         int nbSpaces = 0;
-        currentLineWidth = 0;
+        int currentLineWidth = 0;
         
-        for (int i = count - 1; i >= 0; i--) {
-            if (glyph_info[i].codepoint == spaceCodePoint) {
+        for (int i = shaped.count - 1; i >= 0; i--) {
+            if (shaped.info[i].codepoint == spaceCodePoint) {
                 nbSpaces++;
             } else {
-                textWidth += glyph_pos[i].x_advance;
+                textWidth += shaped.pos[i].x_advance;
             }
-            currentLineWidth += glyph_pos[i].x_advance;
+            currentLineWidth += shaped.pos[i].x_advance;
         }
         
-        bool applySpaceWidth = false;
-        bool changeSize = true;
-        
         if (currentLineWidth > lineWidth) {
-            if (changeSize) {
-                double ratio = (double)lineWidth / currentLineWidth;
-                canvas->scale(ratio, ratio);
-                scale = scale / ratio;
-                currentLineWidth = lineWidth;
-                textWidth = textWidth * ratio;
-            }
+            fit.ratio = (double)lineWidth / currentLineWidth;
+            currentLineWidth = lineWidth;
         } else if (textWidth < lineWidth) {
             // Match DigitalKhatt/mushaf-android exactly: always apply space stretching
             // when text is narrower than line width (after kashida justification)
-            spaceWidth = (lineWidth - textWidth) / (double)nbSpaces;
-            applySpaceWidth = true;
+            fit.spaceWidth = (lineWidth - textWidth) / (double)nbSpaces;
+            fit.stretchSpaces = lineText.just_type == JustType::just;
         }
         
         if (lineText.just_type == JustType::center) {
-            auto pad = (lineWidth - currentLineWidth) / 2;
-            canvas->translate(-pad, 0);
+            fit.startX = -(lineWidth - currentLineWidth) / 2;
         }
         
-        for (int i = count - 1; i >= 0; i--) {
-            auto glyph_index = glyph_info[i].codepoint;
-            bool extend = false;
-            
-            // CRITICAL: Set font variation coordinates BEFORE any canvas transformations
-            // This ensures glyph shapes are calculated correctly for kashida extension
-            if (glyph_info[i].lefttatweel != 0 || glyph_info[i].righttatweel != 0) {
-                extend = true;
-                coords[0] = roundf(glyph_info[i].lefttatweel * 16384.f);
-                coords[1] = roundf(glyph_info[i].righttatweel * 16384.f);
-                font->num_coords = 2;
-                font->coords = &coords[0];
+        return fit;
+    }
+    
+    void drawLine(QuranLine& lineText, skia_context_t* context, double lineWidth, bool justify, double scale, hb_color_t defaultTextColor = HB_COLOR(0, 0, 0, 255), bool disableTajweed = false) {
+        auto canvas = context->canvas;
+        
+        // Disable tajweed for surah name lines - they should be plain black text
+        bool useTajweed = tajweed && !disableTajweed;
+        
+        auto shaped = shapeLine(lineText, lineWidth, justify, useTajweed);
+        
+        const LineFit fit = fitLine(lineText, *shaped, lineWidth);
+        if (fit.ratio != 1.0) {
+            canvas->scale(fit.ratio, fit.ratio);
+        }
+        canvas->translate(fit.startX, 0);
+        
+        paintGlyphs(context, *shaped, fit, defaultTextColor, useTajweed);
+    }
+    
+    // Extents of a shaped glyph, including its kashida variation, memoized
+    const hb_glyph_extents_t& glyphExtents(const hb_glyph_info_t& info) {
+        int coord0 = static_cast<int>(roundf(info.lefttatweel * 16384.f));
+        int coord1 = static_cast<int>(roundf(info.righttatweel * 16384.f));
+        uint64_t key = glyphInstanceKey(info.codepoint, coord0, coord1);
+        
+        auto it = glyphExtentsCache.find(key);
+        if (it != glyphExtentsCache.end()) {
+            return it->second;
+        }
+        
+        // Justified text produces many instances; start over rather than grow unbounded
+        if (glyphExtentsCache.size() >= 65536) {
+            glyphExtentsCache.clear();
+        }
+        
+        hb_glyph_extents_t extents = {0, 0, 0, 0};
+        bool extend = coord0 != 0 || coord1 != 0;
+        if (extend) {
+            coords[0] = coord0;
+            coords[1] = coord1;
+            font->num_coords = 2;
+            font->coords = &coords[0];
+        }
+        hb_font_get_glyph_extents(font, info.codepoint, &extents);
+        if (extend) {
+            font->num_coords = 0;
+            font->coords = nullptr;
+        }
+        
+        return glyphExtentsCache.emplace(key, extents).first->second;
+    }
+    
+    // Ink box of a shaped run in font units (y up), relative to the pen origin
+    // at the right edge of the run. Returns false when nothing is inked.
+    bool inkBounds(const ShapedText& shaped, const LineFit& fit,
+                   double* left, double* bottom, double* right, double* top,
+                   uint32_t clusterStart = 0, uint32_t clusterEnd = UINT32_MAX) {
+        bool inked = false;
+        double pen = fit.startX;
+        
+        for (int i = shaped.count - 1; i >= 0; i--) {
+            pen -= fit.advance(shaped, i);
+            if (shaped.info[i].cluster < clusterStart || shaped.info[i].cluster >= clusterEnd) {
+                continue;
             }
             
-            // CRITICAL FIX: Move by x_advance first, THEN apply positioning offsets
-            // This matches DigitalKhatt/mushaf-android line 165-184 exactly
-            // The order matters: advance positioning happens in logical space,
-            // then glyph-specific offsets (for marks, etc.) are applied
-            if (glyph_info[i].codepoint == spaceCodePoint && lineText.just_type == JustType::just && applySpaceWidth) {
-                canvas->translate(-spaceWidth, 0);
-            } else {
-                canvas->translate(-glyph_pos[i].x_advance, 0);
+            const hb_glyph_extents_t& extents = glyphExtents(shaped.info[i]);
+            if (extents.width == 0 || extents.height == 0) {
+                continue;
             }
             
-            // Apply glyph positioning offset (for vowel marks, etc.)
-            canvas->translate(glyph_pos[i].x_offset, glyph_pos[i].y_offset);
-            
-            // Tajweed color handling:
-            // DigitalKhatt fonts can encode tajweed colors in two ways:
-            // 1. Embedded in base_codepoint during GPOS processing (older fonts)
-            // 2. External application-level logic via regex analysis (DigitalKhattV2 and web implementation)
-            //
-            // This implementation handles method #1. For DigitalKhattV2, tajweed colors
-            // are determined by JavaScript regex in tajweed.service.ts on the web, not embedded in the font.
-            // The color categories are: green (idgham/ikhfa), tafkim (dark blue), lgray (silent letters),
-            // lkalkala (light blue), red1-4 (various madd counts).
-            //
-            // If using DigitalKhattV2 and need tajweed colors, implement the regex patterns from:
-            // https://github.com/DigitalKhatt/digitalkhatt.org/blob/master/ClientApp/src/app/services/tajweed.service.ts
-            
-            auto color = defaultTextColor; // Use computed text color based on background
+            double x0 = pen + shaped.pos[i].x_offset + extents.x_bearing;
+            double x1 = x0 + extents.width;
+            double y1 = shaped.pos[i].y_offset + extents.y_bearing;
+            double y0 = y1 + extents.height;   // height is negative (y up)
             
-            // Tajweed color check: lookup_index >= tajweedcolorindex indicates a tajweed lookup was applied
-            // and base_codepoint contains the RGB color encoded by HarfBuzz during GPOS processing
-            if (useTajweed && glyph_pos[i].lookup_index >= tajweedcolorindex) {
-                color = HB_COLOR(
-                    (glyph_pos[i].base_codepoint >> 8) & 0xff,
-                    (glyph_pos[i].base_codepoint >> 16) & 0xff,
-                    (glyph_pos[i].base_codepoint >> 24) & 0xff,
-                    255
-                );
-            }
-            // Update context foreground before painting so COLR use_foreground layers
-            // can access it.
-            context->foreground = color;
-            hb_font_paint_glyph(font, glyph_index, paint_funcs, context, 0, color);
-            
-            // CRITICAL: Undo the positioning offset to restore canvas state
-            // This must happen BEFORE resetting font coords
-            canvas->translate(-glyph_pos[i].x_offset, -glyph_pos[i].y_offset);
-            
-            // Reset font variation coordinates AFTER all transformations complete
-            if (extend) {
-                font->num_coords = 0;
-                font->coords = nullptr;
+            if (!inked) {
+                *left = std::min(x0, x1);
+                *right = std::max(x0, x1);
+                *bottom = std::min(y0, y1);
+                *top = std::max(y0, y1);
+                inked = true;
+            } else {
+                *left = std::min(*left, std::min(x0, x1));
+                *right = std::max(*right, std::max(x0, x1));
+                *bottom = std::min(*bottom, std::min(y0, y1));
+                *top = std::max(*top, std::max(y0, y1));
             }
         }
         
-        hb_buffer_destroy(buffer);
+        return inked;
     }
     
-    void drawPage(void* pixels, int width, int height, int stride, int pageIndex, bool justify, float fontScale = 1.0f, uint32_t backgroundColor = 0xFFFFFFFF, int fontSize = 0, bool useForeground = false, float lineHeightDivisor = 0.0f, float topMarginLines = -1.0f, QuranPixelFormat format = QURAN_PIXEL_FORMAT_RGBA8888) {
-        // Respect the pixel format - critical for cross-platform compatibility
-        // Android uses RGBA8888, iOS/macOS may use BGRA8888
-        SkColorType colorType = (format == QURAN_PIXEL_FORMAT_BGRA8888)
-            ? kBGRA_8888_SkColorType
-            : kRGBA_8888_SkColorType;
-        SkImageInfo imageInfo = SkImageInfo::Make(width, height, colorType, kPremul_SkAlphaType);
-        auto canvas = SkCanvas::MakeRasterDirect(imageInfo, pixels, stride);
+    // Curve tolerance of the render settings in glyph units at the current
+    // canvas scale, and the device outline cache for COLR layers
+    void setGlyphFill(skia_context_t* context) {
+        const float deviceScale = std::abs(context->canvas->getTotalMatrix().getScaleX());
+        context->flatten_tolerance = (render.flattenTolerance > 0 && deviceScale > 0)
+            ? render.flattenTolerance / deviceScale
+            : 0.0f;
+        context->device_outline = render.deviceOutlines ? &QuranRendererImpl::deviceOutlineSource : nullptr;
+        context->device_outline_data = this;
+    }
+    
+    static bool deviceOutlineSource(void* data, SkCanvas* canvas, hb_font_t* glyphFont, hb_codepoint_t glyph,
+                                    SkPath* path, SkMatrix* matrix) {
+        return static_cast<QuranRendererImpl*>(data)->deviceOutline(canvas, glyphFont, glyph, path, matrix);
+    }
+    
+    // Outline of a glyph at the canvas's current matrix from the device outline
+    // cache. The cached path holds the scale and the subpixel part of the
+    // glyph origin, quantized to the level's bins; *matrix is the whole-pixel
+    // translation to draw it with. Returns false unless the matrix is a plain
+    // scale and translation.
+    bool deviceOutline(SkCanvas* canvas, hb_font_t* glyphFont, hb_codepoint_t glyph, SkPath* path, SkMatrix* matrix) {
+        const SkMatrix& total = canvas->getTotalMatrix();
+        if (!total.isScaleTranslate() || total.getScaleX() == 0 || total.getScaleY() == 0) {
+            return false;
+        }
         
-        // Extract RGBA components from backgroundColor (0xRRGGBBAA format)
-        uint8_t bg_r = (backgroundColor >> 24) & 0xFF;
-        uint8_t bg_g = (backgroundColor >> 16) & 0xFF;
-        uint8_t bg_b = (backgroundColor >> 8) & 0xFF;
-        uint8_t bg_a = backgroundColor & 0xFF;
-        canvas->drawColor(SkColorSetARGB(bg_a, bg_r, bg_g, bg_b));
+        const float bins = static_cast<float>(render.subpixelBins > 0 ? render.subpixelBins : kOutlineSubpixelBins);
+        float originX = std::floor(total.getTranslateX());
+        float originY = std::floor(total.getTranslateY());
+        float offsetX = std::round((total.getTranslateX() - originX) * bins) / bins;
+        float offsetY = std::round((total.getTranslateY() - originY) * bins) / bins;
+        if (offsetX >= 1.0f) {
+            originX += 1.0f;
+            offsetX = 0.0f;
+        }
+        if (offsetY >= 1.0f) {
+            originY += 1.0f;
+            offsetY = 0.0f;
+        }
         
-        SkPaint paint;
-        paint.setColor(SK_ColorBLACK);
-        paint.setAntiAlias(true);
-        paint.setStyle(SkPaint::kFill_Style);
+        const OutlineKey key{
+            glyphFont,
+            glyphInstanceKey(glyph, glyphFont->num_coords > 0 ? glyphFont->coords[0] : 0,
+                             glyphFont->num_coords > 1 ? glyphFont->coords[1] : 0),
+            total.getScaleX(), total.getScaleY(), render.flattenTolerance, offsetX, offsetY
+        };
+        std::shared_ptr<const SkPath> cached = outlineCache.get(key);
+        if (!cached) {
+            const float deviceScale = std::abs(total.getScaleX());
+            SkPathBuilder builder;
+            hb_skia_flatten_glyph(glyphFont, glyph, &builder,
+                                  render.flattenTolerance > 0 ? render.flattenTolerance / deviceScale : 0.0f);
+            SkMatrix toDevice = SkMatrix::Translate(offsetX, offsetY);
+            toDevice.preScale(total.getScaleX(), total.getScaleY());
+            auto devicePath = std::make_shared<SkPath>(builder.detach().makeTransform(toDevice));
+            outlineCache.put(key, devicePath, sizeof(SkPath) + devicePath->approximateBytesUsed());
+            cached = std::move(devicePath);
+        }
         
-        skia_context_t context{};
-        context.canvas = canvas.get();
-        context.paint = &paint;
-        context.foreground = HB_COLOR(0, 0, 0, 255);
-        context.backgroundColor = HB_COLOR(bg_r, bg_g, bg_b, bg_a);
-        context.use_foreground_override = useForeground;
+        *path = *cached;
+        *matrix = SkMatrix::Translate(originX, originY);
+        return true;
+    }
+    
+    // Fills a glyph's outline with a single color (flattened and mono COLR detail)
+    void drawGlyphOutline(skia_context_t* context, hb_font_t* glyphFont, hb_codepoint_t glyph, hb_color_t color) {
+        if (render.distanceFields && glyphFont == font) {
+            fillGlyphSdf(context, glyph, color);
+            return;
+        }
+        if (render.glyphRasterizer && render.antiAlias) {
+            fillGlyphCoverage(context, glyphFont, glyph, color);
+            return;
+        }
         
-        auto& pageText = pages[pageIndex];
+        context->paint->setColor(SkColorSetARGB(hb_color_get_alpha(color), hb_color_get_red(color),
+                                                hb_color_get_green(color), hb_color_get_blue(color)));
+        
+        SkPath path;
+        SkMatrix matrix;
+        if (render.deviceOutlines && deviceOutline(context->canvas, glyphFont, glyph, &path, &matrix)) {
+            context->canvas->save();
+            context->canvas->setMatrix(matrix);
+            context->canvas->drawPath(path, *context->paint);
+            context->canvas->restore();
+            return;
+        }
+        
+        SkPathBuilder builder;
+        hb_skia_flatten_glyph(glyphFont, glyph, &builder, context->flatten_tolerance);
+        context->canvas->drawPath(builder.detach(), *context->paint);
+    }
+    
+    // drawGlyphOutline through GlyphRasterizer: the outline is flattened in
+    // device space, rasterized to an A8 mask over its pixel bounds and the mask
+    // drawn in the fill color
+    void fillGlyphCoverage(skia_context_t* context, hb_font_t* glyphFont, hb_codepoint_t glyph, hb_color_t color) {
+        SkCanvas* canvas = context->canvas;
+        const SkMatrix matrix = canvas->getTotalMatrix();
+        
+        // The rasterizer only takes lines: flatten even when the level keeps curves
+        float tolerance = context->flatten_tolerance;
+        if (tolerance <= 0) {
+            const float deviceScale = std::abs(matrix.getScaleX());
+            tolerance = deviceScale > 0 ? 0.1f / deviceScale : 1.0f;
+        }
+        
+        glyphSegments.clear();
+        hb_skia_glyph_segments(glyphFont, glyph, matrix, tolerance, &glyphSegments);
+        if (glyphSegments.empty()) return;
+        
+        float minX = glyphSegments[0], maxX = minX;
+        float minY = glyphSegments[1], maxY = minY;
+        for (size_t i = 0; i < glyphSegments.size(); i += 2) {
+            minX = std::min(minX, glyphSegments[i]);
+            maxX = std::max(maxX, glyphSegments[i]);
+            minY = std::min(minY, glyphSegments[i + 1]);
+            maxY = std::max(maxY, glyphSegments[i + 1]);
+        }
+        
+        // Pixel bounds, cut to the clip so off-screen parts cost nothing
+        SkIRect bounds = SkIRect::MakeLTRB(static_cast<int>(std::floor(minX)), static_cast<int>(std::floor(minY)),
+                                           static_cast<int>(std::ceil(maxX)), static_cast<int>(std::ceil(maxY)));
+        if (!bounds.intersect(canvas->getDeviceClipBounds())) return;
+        
+        rasterizer.reset(bounds.width(), bounds.height());
+        for (size_t i = 0; i < glyphSegments.size(); i += 4) {
+            rasterizer.line(glyphSegments[i] - bounds.left(), glyphSegments[i + 1] - bounds.top(),
+                            glyphSegments[i + 2] - bounds.left(), glyphSegments[i + 3] - bounds.top());
+        }
+        glyphMask.resize(static_cast<size_t>(bounds.width()) * bounds.height());
+        rasterizer.coverage(glyphMask.data(), bounds.width());
+        
+        drawGlyphMask(context, bounds, color);
+    }
+    
+    // drawGlyphOutline from the glyph instance's distance field, built on
+    // first use; the outline is not touched again at any scale
+    void fillGlyphSdf(skia_context_t* context, hb_codepoint_t glyph, hb_color_t color) {
+        const uint64_t key = glyphInstanceKey(glyph, font->num_coords > 0 ? font->coords[0] : 0,
+                                              font->num_coords > 1 ? font->coords[1] : 0);
+        std::shared_ptr<const GlyphSdf> sdf = sdfCache.get(key);
+        if (!sdf) {
+            sdf = quranBuildGlyphSdf(font, glyph);
+            if (!sdf) return;
+            sdfCache.put(key, sdf, sdf->bytes());
+        }
+        
+        SkCanvas* canvas = context->canvas;
+        SkIRect bounds;
+        if (!quranSampleGlyphSdf(*sdf, canvas->getTotalMatrix(), canvas->getDeviceClipBounds(), &glyphMask, &bounds)) {
+            return;
+        }
+        drawGlyphMask(context, bounds, color);
+    }
+    
+    // Draws glyphMask (A8, bounds in device pixels) in a color
+    void drawGlyphMask(skia_context_t* context, const SkIRect& bounds, hb_color_t color) {
+        SkCanvas* canvas = context->canvas;
+        SkBitmap mask;
+        mask.installPixels(SkImageInfo::MakeA8(bounds.width(), bounds.height()), glyphMask.data(), bounds.width());
+        mask.setImmutable();
         
-        // =========================================================================
-        // ADAPTIVE LAYOUT - Based on DigitalKhatt formulas with orientation support
-        // DigitalKhatt uses fixed aspect ratio (1.618). We adapt to any aspect ratio.
-        // =========================================================================
+        // Alpha-only images are drawn in the paint's color
+        context->paint->setColor(SkColorSetARGB(hb_color_get_alpha(color), hb_color_get_red(color),
+                                                hb_color_get_green(color), hb_color_get_blue(color)));
+        canvas->save();
+        canvas->resetMatrix();
+        canvas->drawImage(mask.asImage(), bounds.left(), bounds.top(), SkSamplingOptions(), context->paint);
+        canvas->restore();
+    }
+    
+    // Clears the buffer of a draw call as its clear mode asks. Returns true for
+    // a QURAN_CLEAR_DIRTY draw, whose ink is recorded until endFrame.
+    bool beginFrame(SkCanvas* canvas, const QuranPixelBuffer& target, uint32_t background, QuranClearMode mode) {
+        const bool opaque = (background & 0xFF) == 0xFF;
+        const bool sameBuffer = lastFrame.pixels == target.pixels && lastFrame.width == target.width &&
+                                lastFrame.height == target.height && lastFrame.stride == target.stride &&
+                                lastFrame.format == target.format && lastFrame.background == background;
+        
+        if (mode == QURAN_CLEAR_DIRTY && opaque && sameBuffer) {
+            SkIRect dirty = lastFrame.ink;
+            if (dirty.intersect(SkIRect::MakeWH(target.width, target.height))) {
+                fillPixels(target.pixels, target.stride, dirty, backgroundPixel(background, target.format));
+            }
+        } else if (mode != QURAN_CLEAR_NONE) {
+            canvas->drawColor(SkColorSetARGB(background & 0xFF, (background >> 24) & 0xFF,
+                                             (background >> 16) & 0xFF, (background >> 8) & 0xFF));
+        }
+        
+        forgetFrame(target);
+        recordingInk = mode == QURAN_CLEAR_DIRTY && opaque;
+        if (recordingInk) {
+            frame = Frame{target.pixels, target.width, target.height, target.stride, target.format,
+                          background, SkIRect::MakeEmpty()};
+        }
+        return recordingInk;
+    }
+    
+    // Keeps the recorded draw, with its ink or the given rectangle, for the next
+    // QURAN_CLEAR_DIRTY draw into the buffer
+    void endFrame(const SkIRect& ink) {
+        lastFrame = frame;
+        lastFrame.ink = ink;
+        recordingInk = false;
+    }
+    void endFrame() { endFrame(frame.ink); }
+    
+    // Drops the recorded draw when another draw touches its pixels
+    void forgetFrame(const QuranPixelBuffer& target) {
+        if (!lastFrame.pixels) return;
+        const uintptr_t begin = reinterpret_cast<uintptr_t>(lastFrame.pixels);
+        const uintptr_t end = begin + static_cast<size_t>(lastFrame.stride) * lastFrame.height;
+        const uintptr_t targetBegin = reinterpret_cast<uintptr_t>(target.pixels);
+        const uintptr_t targetEnd = targetBegin + static_cast<size_t>(target.stride) * target.height;
+        if (targetBegin < end && begin < targetEnd) {
+            lastFrame.pixels = nullptr;
+        }
+    }
+    
+    // Adds a rectangle in current canvas coordinates to the recorded ink, with
+    // room for anti-aliasing and subpixel snapping
+    void recordInk(SkCanvas* canvas, const SkRect& rect) {
+        SkIRect device = canvas->getTotalMatrix().mapRect(rect).roundOut();
+        device.outset(2, 2);
+        frame.ink.join(device);
+    }
+    
+    // Paints a shaped run right to left from the current canvas origin (font units, y up).
+    // Glyphs of clusters outside [clusterStart, clusterEnd) only advance the pen.
+    void paintGlyphs(skia_context_t* context, const ShapedText& shaped, const LineFit& fit,
+                     hb_color_t defaultTextColor, bool useTajweed,
+                     uint32_t clusterStart = 0, uint32_t clusterEnd = UINT32_MAX) {
+        auto canvas = context->canvas;
+        const unsigned count = shaped.count;
+        const hb_glyph_info_t* glyph_info = shaped.info;
+        const hb_glyph_position_t* glyph_pos = shaped.pos;
+        
+        // The run is drawn at one scale, so the tolerance holds for every glyph
+        setGlyphFill(context);
+        const bool perGlyphColor = render.colr != ColrDetail::Mono;
+        
+        if (recordingInk) {
+            // inkBounds starts the pen at fit.startX, which the canvas origin already includes
+            double left, bottom, right, top;
+            if (inkBounds(shaped, fit, &left, &bottom, &right, &top, clusterStart, clusterEnd)) {
+                recordInk(canvas, SkRect::MakeLTRB(left - fit.startX, bottom, right - fit.startX, top));
+            }
+        }
+        
+        for (int i = count - 1; i >= 0; i--) {
+            if (glyph_info[i].cluster < clusterStart || glyph_info[i].cluster >= clusterEnd) {
+                canvas->translate(-fit.advance(shaped, i), 0);
+                continue;
+            }
+            
+            auto glyph_index = glyph_info[i].codepoint;
+            bool extend = false;
+            
+            // CRITICAL: Set font variation coordinates BEFORE any canvas transformations
+            // This ensures glyph shapes are calculated correctly for kashida extension
+            if (glyph_info[i].lefttatweel != 0 || glyph_info[i].righttatweel != 0) {
+                extend = true;
+                coords[0] = roundf(glyph_info[i].lefttatweel * 16384.f);
+                coords[1] = roundf(glyph_info[i].righttatweel * 16384.f);
+                font->num_coords = 2;
+                font->coords = &coords[0];
+            }
+            
+            // CRITICAL FIX: Move by x_advance first, THEN apply positioning offsets
+            // This matches DigitalKhatt/mushaf-android line 165-184 exactly
+            // The order matters: advance positioning happens in logical space,
+            // then glyph-specific offsets (for marks, etc.) are applied
+            canvas->translate(-fit.advance(shaped, i), 0);
+            
+            // Apply glyph positioning offset (for vowel marks, etc.)
+            canvas->translate(glyph_pos[i].x_offset, glyph_pos[i].y_offset);
+            
+            // Snap the glyph origin to the subpixel grid of the quality level
+            SkScalar snapX = 0, snapY = 0;
+            if (render.subpixelBins > 0) {
+                const SkMatrix& matrix = canvas->getTotalMatrix();
+                const float bins = static_cast<float>(render.subpixelBins);
+                const float tx = matrix.getTranslateX();
+                const float ty = matrix.getTranslateY();
+                snapX = (std::round(tx * bins) / bins - tx) / matrix.getScaleX();
+                snapY = (std::round(ty * bins) / bins - ty) / matrix.getScaleY();
+                canvas->translate(snapX, snapY);
+            }
+            
+            // Tajweed color handling:
+            // DigitalKhatt fonts can encode tajweed colors in two ways:
+            // 1. Embedded in base_codepoint during GPOS processing (older fonts)
+            // 2. External application-level logic via regex analysis (DigitalKhattV2 and web implementation)
+            //
+            // Method #1 is decoded below. For method #2 the page lines are classified once at load
+            // time (tajweed_classifier.cpp, after tajweed.service.ts) and the class of each glyph's
+            // cluster selects the color. The color categories are: green (idgham/ikhfa), tafkim
+            // (dark blue), lgray (silent letters), lkalkala (light blue), red1-4 (various madd counts).
+            
+            auto color = defaultTextColor; // Use computed text color based on background
+            
+            // Tajweed color check: lookup_index >= tajweedcolorindex indicates a tajweed lookup was applied
+            // and base_codepoint contains the RGB color encoded by HarfBuzz during GPOS processing.
+            // Both kinds of tajweed color come from the table of resolveColors (the caller's
+            // background and theme).
+            if (!perGlyphColor) {
+                // Mono: every glyph in the text color
+            } else if (useTajweed && glyph_pos[i].lookup_index >= tajweedcolorindex) {
+                color = embeddedTajweedColor(glyph_pos[i].base_codepoint);
+            } else if (useTajweed && shaped.tajweedClasses) {
+                uint8_t tajweedClass = shaped.tajweedClasses[glyph_info[i].cluster];
+                if (tajweedClass != static_cast<uint8_t>(TajweedClass::None)) {
+                    color = colors.tajweed[tajweedClass];
+                }
+            }
+            if (render.colr != ColrDetail::Full) {
+                // One fill per glyph, no COLR layers
+                drawGlyphOutline(context, font, glyph_index, color);
+            } else {
+                // Update context foreground before painting so COLR use_foreground layers
+                // can access it.
+                context->foreground = color;
+                hb_font_paint_glyph(font, glyph_index, paint_funcs, context, 0, color);
+            }
+            
+            // CRITICAL: Undo the positioning offset to restore canvas state
+            // This must happen BEFORE resetting font coords
+            canvas->translate(-glyph_pos[i].x_offset - snapX, -glyph_pos[i].y_offset - snapY);
+            
+            // Reset font variation coordinates AFTER all transformations complete
+            if (extend) {
+                font->num_coords = 0;
+                font->coords = nullptr;
+            }
+        }
+    }
+    
+    // =========================================================================
+    // ADAPTIVE LAYOUT - Based on DigitalKhatt formulas with orientation support
+    // DigitalKhatt uses fixed aspect ratio (1.618). We adapt to any aspect ratio.
+    // =========================================================================
+    PageLayout computePageLayout(int width, int height, int pageIndex) const {
+        PageLayout layout;
         
         // Font size: Always use DigitalKhatt formula (width / 17) * 0.9
         // This keeps the font size consistent and large
-        int char_height = static_cast<int>((width / 17.0) * 0.9);
+        layout.char_height = static_cast<int>((width / 17.0) * 0.9);
         
         // Line spacing: Start with DigitalKhatt formula (height / 15)
         int inter_line_from_height = height / 15;
@@ -678,40 +1760,112 @@ struct QuranRendererImpl {
         // ADAPTIVE: Ensure inter_line is large enough to fit the font without overlaps
         // Arabic text with diacritics needs ~1.55x char_height for proper spacing
         // This handles landscape where height-based spacing would be too small
-        int min_inter_line = static_cast<int>(char_height * 1.55);
-        int inter_line = std::max(inter_line_from_height, min_inter_line);
+        int min_inter_line = static_cast<int>(layout.char_height * 1.55);
+        layout.inter_line = std::max(inter_line_from_height, min_inter_line);
         
         // y_start = inter_line * 0.72
-        int y_start = static_cast<int>(inter_line * 0.72);
+        layout.y_start = static_cast<int>(layout.inter_line * 0.72);
         
         // x_padding = width / 42.5
-        int x_padding = static_cast<int>(width / 42.5);
+        layout.x_padding = static_cast<int>(width / 42.5);
         
         // scale = char_height / upem
-        double scale = (double)char_height / upem;
+        layout.scale = (double)layout.char_height / upem;
         
         // x_start = width - x_padding
-        int x_start = width - x_padding;
+        layout.x_start = width - layout.x_padding;
         
         // pageWidth = (width - 2*x_padding) / scale
-        double pageWidth = (width - 2 * x_padding) / scale;
+        layout.pageWidth = (width - 2 * layout.x_padding) / layout.scale;
         
         // Special handling for Fatiha pages (page 0 and 1)
         if (pageIndex == 0 || pageIndex == 1) {
-            y_start = y_start + static_cast<int>(3.5 * inter_line);
+            layout.y_start = layout.y_start + static_cast<int>(3.5 * layout.inter_line);
+        }
+        
+        return layout;
+    }
+    
+    LineBox computeLineBox(const PageLayout& layout, int pageIndex, int lineIndex) const {
+        LineBox box;
+        box.lineWidth = layout.pageWidth;
+        box.originX = layout.x_start;
+        box.baseline = layout.y_start + lineIndex * layout.inter_line;
+        
+        // Exact match to DigitalKhatt: special line widths for certain pages/lines
+        auto specialWidth = lineWidths.find(pageIndex * 15 + lineIndex);
+        if (specialWidth != lineWidths.end()) {
+            box.lineWidth = layout.pageWidth * specialWidth->second;
+            float xxstart = (layout.pageWidth - box.lineWidth) / 2;
+            box.originX = layout.x_start - xxstart * layout.scale;
         }
         
-        // =========================================================================
-        // END LAYOUT - below is rendering logic
-        // =========================================================================
+        return box;
+    }
+    
+    // Header dimensions - centered, spans most of the page width
+    void computeSurahHeaderRect(const PageLayout& layout, int width, int lineIndex,
+                                float* x, float* y, float* w, float* h) const {
+        *w = (width - 2 * layout.x_padding) * 0.8f;
+        *h = layout.inter_line * 0.8f;
+        *x = layout.x_padding + (width - 2 * layout.x_padding - *w) / 2;
+        *y = layout.y_start + lineIndex * layout.inter_line - layout.inter_line * 0.6f;
+    }
+    
+    // Surah of the header on a Sura line: the first surah starting on the
+    // page plus the Sura lines above it (page 604 has three headers)
+    int headerSurahNumber(int pageIndex, int lineIndex) const {
+        int first = -1;
+        for (int s = 1; s <= 114; s++) {
+            if (quran_renderer_get_surah_start_page(s) == pageIndex) {
+                first = s;
+                break;
+            }
+        }
+        if (first < 0) return -1;
+        
+        const auto& pageText = pages[pageIndex];
+        int surahNumber = first;
+        for (int i = 0; i < lineIndex; i++) {
+            if (pageText[i].line_type == LineType::Sura) surahNumber++;
+        }
+        return surahNumber <= 114 ? surahNumber : -1;
+    }
+    
+    void drawPage(void* pixels, int width, int height, int stride, int pageIndex, bool justify, float fontScale = 1.0f, uint32_t backgroundColor = 0xFFFFFFFF, int fontSize = 0, bool useForeground = false, float lineHeightDivisor = 0.0f, float topMarginLines = -1.0f, QuranPixelFormat format = QURAN_PIXEL_FORMAT_RGBA8888, QuranClearMode clearMode = QURAN_CLEAR_FULL) {
+        // Respect the pixel format - critical for cross-platform compatibility
+        // Android uses RGBA8888, iOS/macOS may use BGRA8888
+        SkColorType colorType = (format == QURAN_PIXEL_FORMAT_BGRA8888)
+            ? kBGRA_8888_SkColorType
+            : kRGBA_8888_SkColorType;
+        SkImageInfo imageInfo = SkImageInfo::Make(width, height, colorType, kPremul_SkAlphaType);
+        auto canvas = SkCanvas::MakeRasterDirect(imageInfo, pixels, stride);
+        
+        const QuranPixelBuffer target = {pixels, width, height, stride, format};
+        const bool recorded = beginFrame(canvas.get(), target, backgroundColor, clearMode);
+        
+        SkPaint paint;
+        paint.setColor(SK_ColorBLACK);
+        paint.setAntiAlias(render.antiAlias);
+        paint.setStyle(SkPaint::kFill_Style);
+        
+        skia_context_t context{};
+        context.canvas = canvas.get();
+        context.paint = &paint;
+        context.use_foreground_override = useForeground;
+        
+        auto& pageText = pages[pageIndex];
+        
+        const PageLayout layout = computePageLayout(width, height, pageIndex);
         
-        // Compute text color based on background luminance
-        hb_color_t textColor = getTextColorForBackground(backgroundColor);
+        // Text color from the theme, or based on background luminance
+        const ColorTable& resolved = resolveColors(backgroundColor);
+        hb_color_t textColor = resolved.text;
 
         // Ensure foreground color follows the computed text color.
         // This matters when COLR/painted glyphs request "use_foreground"; in that case
         // hb_skia_paint_color may use context.foreground (when override is enabled).
-        context.foreground = textColor;
+        setContextColors(&context, resolved);
         paint.setColor(SkColorSetARGB(
             hb_color_get_alpha(textColor),
             hb_color_get_red(textColor),
@@ -720,124 +1874,1399 @@ struct QuranRendererImpl {
         ));
         
         for (size_t lineIndex = 0; lineIndex < pageText.size(); lineIndex++) {
-            canvas->resetMatrix();
+            drawPageLine(canvas.get(), &context, layout, width, pageIndex, static_cast<int>(lineIndex),
+                         justify, textColor, backgroundColor);
+        }
+        
+        if (recorded) endFrame();
+    }
+    
+    // Right page at the right edge, its facing page at the left edge, with a
+    // gutter between them. The left page is drawn by the spread worker on a
+    // second thread when the device has more than one core.
+    void drawSpread(QuranPixelBuffer* buffer, int rightPage, const QuranRenderConfig* config) {
+        const int width = buffer->width;
+        const int height = buffer->height;
+        const int gutter = std::max(2, width / 40);
+        const int pageWidth = (width - gutter) / 2;
+        if (pageWidth <= 0) return;
+        
+        const bool useTajweed = config ? config->tajweed : true;
+        const bool justify = config ? config->justify : true;
+        const float fontScale = config ? config->fontScale : 1.0f;
+        const uint32_t backgroundColor = config ? config->backgroundColor : 0xFFFFFFFF;
+        const int fontSize = config ? config->fontSize : 0;
+        const bool useForeground = config ? config->useForeground : false;
+        const float lineHeightDivisor = config ? config->lineHeightDivisor : 0.0f;
+        const float topMarginLines = config ? config->topMarginLines : -1.0f;
+        // The halves are page-sized windows, not one recorded frame
+        const QuranClearMode clearMode = (config && config->clearMode == QURAN_CLEAR_NONE)
+            ? QURAN_CLEAR_NONE : QURAN_CLEAR_FULL;
+        
+        SkColorType colorType = (buffer->format == QURAN_PIXEL_FORMAT_BGRA8888)
+            ? kBGRA_8888_SkColorType
+            : kRGBA_8888_SkColorType;
+        SkColor background = SkColorSetARGB(backgroundColor & 0xFF, (backgroundColor >> 24) & 0xFF,
+                                            (backgroundColor >> 16) & 0xFF, (backgroundColor >> 8) & 0xFF);
+        
+        // Gutter: background with a faint rule at the fold
+        {
+            SkImageInfo imageInfo = SkImageInfo::Make(width, height, colorType, kPremul_SkAlphaType);
+            auto canvas = SkCanvas::MakeRasterDirect(imageInfo, buffer->pixels, buffer->stride);
+            canvas->clipRect(SkRect::MakeLTRB(pageWidth, 0, width - pageWidth, height));
+            if (clearMode != QURAN_CLEAR_NONE) canvas->drawColor(background);
             
-            auto lineWidth = pageWidth;
+            hb_color_t textColor = resolveColors(backgroundColor).text;
+            SkPaint rule;
+            rule.setColor(SkColorSetARGB(0x30, hb_color_get_red(textColor),
+                                         hb_color_get_green(textColor), hb_color_get_blue(textColor)));
+            canvas->drawRect(SkRect::MakeXYWH(width / 2.0f - 0.5f, 0, 1, height), rule);
+        }
+        
+        // Each half is a page-sized window into the shared buffer
+        auto drawHalf = [&](QuranRendererImpl* r, int pageIndex, int x) {
+            void* pixels = static_cast<uint8_t*>(buffer->pixels) + x * 4;
+            if (pageIndex >= 604) {
+                // The last page has no facing page
+                if (clearMode == QURAN_CLEAR_NONE) return;
+                SkImageInfo imageInfo = SkImageInfo::Make(pageWidth, height, colorType, kPremul_SkAlphaType);
+                SkCanvas::MakeRasterDirect(imageInfo, pixels, buffer->stride)->drawColor(background);
+                return;
+            }
+            r->setTajweed(useTajweed);
+            r->drawPage(pixels, pageWidth, height, buffer->stride, pageIndex, justify, fontScale,
+                        backgroundColor, fontSize, useForeground, lineHeightDivisor, topMarginLines,
+                        buffer->format, clearMode);
+        };
+        
+        const int leftPage = rightPage + 1;
+        const int rightX = width - pageWidth;
+        
+        if (std::thread::hardware_concurrency() > 1) {
+            QuranRendererImpl* worker = getSpreadWorker();
+            worker->setRenderSettings(render);
+            try {
+                std::thread left([&] { drawHalf(worker, leftPage, 0); });
+                drawHalf(this, rightPage, rightX);
+                left.join();
+                return;
+            } catch (const std::system_error&) {
+                // No thread available: draw both halves here
+            }
+        }
+        
+        drawHalf(this, rightPage, rightX);
+        drawHalf(this, leftPage, 0);
+    }
+    
+    // One line of a page in page coordinates, relative to the current canvas matrix
+    void drawPageLine(SkCanvas* canvas, skia_context_t* context, const PageLayout& layout, int width,
+                      int pageIndex, int lineIndex, bool justify, hb_color_t textColor, uint32_t backgroundColor) {
+        auto& linetext = pages[pageIndex][lineIndex];
+        
+        // Draw surah header using font ligature instead of SVG frame
+        if (linetext.line_type == LineType::Sura && surah_header_font) {
+            int surahNumber = headerSurahNumber(pageIndex, lineIndex);
             
-            // Exact match to DigitalKhatt: special line widths for certain pages/lines
-            auto specialWidth = lineWidths.find(pageIndex * 15 + lineIndex);
-            if (specialWidth != lineWidths.end()) {
-                lineWidth = pageWidth * specialWidth->second;
-                float xxstart = (pageWidth - lineWidth) / 2;
-                canvas->translate(x_start - xxstart * scale, y_start + lineIndex * inter_line);
-            } else {
-                canvas->translate(x_start, y_start + lineIndex * inter_line);
+            if (surahNumber > 0) {
+                float headerX, headerY, headerWidth, headerHeight;
+                computeSurahHeaderRect(layout, width, lineIndex,
+                                       &headerX, &headerY, &headerWidth, &headerHeight);
+                
+                // Use the surah header font to draw the ligature
+                drawSurahHeader(canvas, context, surahNumber,
+                              headerX, headerY, headerWidth, headerHeight, backgroundColor);
+                
+                // Skip rendering the text line - we've already rendered the header
+                return;
             }
+        }
+        
+        const LineBox box = computeLineBox(layout, pageIndex, lineIndex);
+        canvas->save();
+        canvas->translate(box.originX, box.baseline);
+        
+        // Exact match to DigitalKhatt: canvas->scale(scale,-scale);
+        canvas->scale(layout.scale, -layout.scale);
+        
+        // Disable tajweed coloring for surah name lines - they should be plain text
+        bool disableTajweed = (linetext.line_type == LineType::Sura);
+        drawLine(linetext, context, box.lineWidth, justify, layout.scale, textColor, disableTajweed);
+        canvas->restore();
+    }
+    
+    int getPageMetrics(int pageIndex, int width, int height, QuranPageMetrics* metrics,
+                       QuranLineMetrics* lines, int maxLines) const {
+        const auto& pageText = pages[pageIndex];
+        const PageLayout layout = computePageLayout(width, height, pageIndex);
+        const int lineCount = static_cast<int>(pageText.size());
+        
+        if (metrics) {
+            metrics->charHeight = layout.char_height;
+            metrics->interLine = layout.inter_line;
+            metrics->yStart = layout.y_start;
+            metrics->xPadding = layout.x_padding;
+            metrics->scale = static_cast<float>(layout.scale);
+            metrics->lineCount = lineCount;
+        }
+        
+        for (int lineIndex = 0; lineIndex < lineCount && lines && lineIndex < maxLines; lineIndex++) {
+            const LineBox box = computeLineBox(layout, pageIndex, lineIndex);
+            const QuranLine& linetext = pageText[lineIndex];
+            QuranLineMetrics& line = lines[lineIndex];
             
-            auto& linetext = pageText[lineIndex];
+            line.kind = static_cast<QuranLineKind>(linetext.line_type);
+            line.baseline = static_cast<float>(box.baseline);
+            line.right = static_cast<float>(box.originX);
+            line.left = static_cast<float>(box.originX - box.lineWidth * layout.scale);
+            line.hasSurahHeader = false;
+            line.surahNumber = -1;
+            line.headerX = line.headerY = line.headerWidth = line.headerHeight = 0;
             
-            // Draw surah header using font ligature instead of SVG frame
+            // Same condition as drawPage: the header replaces the text line
             if (linetext.line_type == LineType::Sura && surah_header_font) {
-                // Find which surah this is by checking page metadata
-                int surahNumber = -1;
-                for (int s = 1; s <= 114; s++) {
-                    int startPage = quran_renderer_get_surah_start_page(s);
-                    if (startPage == pageIndex) {
-                        surahNumber = s;
-                        break;
-                    }
-                }
-                
-                if (surahNumber > 0) {
-                    canvas->resetMatrix();
-                    // Header dimensions - centered, spans most of the page width
-                    float headerWidth = (width - 2 * x_padding) * 0.8f;
-                    float headerHeight = inter_line * 0.8f;
-                    float headerX = x_padding + (width - 2 * x_padding - headerWidth) / 2;
-                    float headerY = y_start + lineIndex * inter_line - inter_line * 0.6f;
-                    
-                    // Use the surah header font to draw the ligature
-                    drawSurahHeader(canvas.get(), &context, surahNumber,
-                                  headerX, headerY, headerWidth, headerHeight, backgroundColor);
-                    
-                    // Skip rendering the text line - we've already rendered the header
-                    continue;
+                line.surahNumber = headerSurahNumber(pageIndex, lineIndex);
+                if (line.surahNumber > 0) {
+                    line.hasSurahHeader = true;
+                    computeSurahHeaderRect(layout, width, lineIndex,
+                                           &line.headerX, &line.headerY, &line.headerWidth, &line.headerHeight);
                 }
             }
+        }
+        
+        return lineCount;
+    }
+    
+    int getLineClusters(int pageIndex, int lineIndex, int width, int height, bool justify, bool useTajweed,
+                        QuranCluster* clusters, int maxClusters) {
+        auto& pageText = pages[pageIndex];
+        if (lineIndex < 0 || lineIndex >= static_cast<int>(pageText.size())) {
+            return -1;
+        }
+        
+        const QuranLine& linetext = pageText[lineIndex];
+        
+        // The surah header replaces the text line: nothing to select
+        if (linetext.line_type == LineType::Sura && surah_header_font && headerSurahNumber(pageIndex, lineIndex) > 0) {
+            return 0;
+        }
+        
+        const PageLayout layout = computePageLayout(width, height, pageIndex);
+        const LineBox box = computeLineBox(layout, pageIndex, lineIndex);
+        
+        auto shaped = shapeLine(linetext, box.lineWidth, justify, useTajweed && linetext.line_type != LineType::Sura);
+        const LineFit fit = fitLine(linetext, *shaped, box.lineWidth);
+        
+        std::vector<ClusterExtent> extents;
+        collectClusters(*shaped, fit, static_cast<uint32_t>(linetext.text.size()), &extents);
+        
+        // Same transform as drawPage/drawLine: translate(origin) * scale(scale) * scale(ratio)
+        const double xScale = layout.scale * fit.ratio;
+        int count = static_cast<int>(extents.size());
+        for (int k = 0; k < count && clusters && k < maxClusters; k++) {
+            clusters[k].byteStart = static_cast<int>(extents[k].byteStart);
+            clusters[k].byteEnd = static_cast<int>(extents[k].byteEnd);
+            clusters[k].left = static_cast<float>(box.originX + extents[k].left * xScale);
+            clusters[k].right = static_cast<float>(box.originX + extents[k].right * xScale);
+        }
+        
+        return count;
+    }
+    
+    // Lays out ayahs [firstAyah, lastAyah] of a surah on their mushaf lines at
+    // the page geometry of pageWidth, stacked one line slot apart with page
+    // breaks removed. The crop rect covers the ink of the ayahs only, plus
+    // padding: (cropX, cropY) is its top-left in page x / first-baseline y.
+    bool layoutAyahImage(int surahNumber, int firstAyah, int lastAyah, int pageWidth, int padding,
+                         bool justify, bool useTajweed, std::vector<AyahImageLine>* lines,
+                         PageLayout* layout, double* cropX, double* cropY, int* width, int* height) {
+        const QuranTextIndex& textIndex = QuranTextIndex::get();
+        *layout = computePageLayout(pageWidth, 0, 2);
+        
+        std::vector<QuranLineRange> ranges;
+        for (int ayah = firstAyah; ayah <= lastAyah; ayah++) {
+            if (textIndex.ayahLineRanges(surahNumber, ayah, &ranges) == 0) {
+                return false;
+            }
+        }
+        
+        // Consecutive ayahs sharing a line become one segment
+        for (const QuranLineRange& range : ranges) {
+            uint32_t lineStart = textIndex.pages[range.pageIndex].lines[range.lineIndex].start;
+            if (!lines->empty() && lines->back().pageIndex == range.pageIndex &&
+                lines->back().lineIndex == range.lineIndex) {
+                lines->back().byteEnd = range.end - lineStart;
+                continue;
+            }
+            AyahImageLine line{};
+            line.pageIndex = range.pageIndex;
+            line.lineIndex = range.lineIndex;
+            line.byteStart = range.start - lineStart;
+            line.byteEnd = range.end - lineStart;
+            lines->push_back(std::move(line));
+        }
+        
+        double left = 0, top = 0, right = 0, bottom = 0;
+        for (size_t i = 0; i < lines->size(); i++) {
+            AyahImageLine& line = (*lines)[i];
+            const QuranLine& lineText = pages[line.pageIndex][line.lineIndex];
+            
+            // Shaped and fitted exactly as drawPage does, so the segment
+            // matches the page rendering
+            line.box = computeLineBox(*layout, line.pageIndex, line.lineIndex);
+            line.shaped = shapeLine(lineText, line.box.lineWidth, justify, useTajweed);
+            line.fit = fitLine(lineText, *line.shaped, line.box.lineWidth);
+            
+            double inkLeft, inkBottom, inkRight, inkTop;
+            if (!inkBounds(*line.shaped, line.fit, &inkLeft, &inkBottom, &inkRight, &inkTop,
+                           line.byteStart, line.byteEnd)) {
+                inkLeft = inkBottom = inkRight = inkTop = 0;
+            }
             
-            // Exact match to DigitalKhatt: canvas->scale(scale,-scale);
-            canvas->scale(scale, -scale);
+            // drawLine scales by the fit ratio on both axes
+            const double lineScale = layout->scale * line.fit.ratio;
+            line.left = line.box.originX + inkLeft * lineScale;
+            line.right = line.box.originX + inkRight * lineScale;
+            line.top = -inkTop * lineScale;
+            line.bottom = -inkBottom * lineScale;
             
-            // Disable tajweed coloring for surah name lines - they should be plain text
-            bool disableTajweed = (linetext.line_type == LineType::Sura);
-            drawLine(linetext, &context, lineWidth, justify, scale, textColor, disableTajweed);
+            double slot = static_cast<double>(i) * layout->inter_line;
+            if (i == 0) {
+                left = line.left;
+                right = line.right;
+                top = line.top;
+                bottom = line.bottom;
+            } else {
+                left = std::min(left, line.left);
+                right = std::max(right, line.right);
+                top = std::min(top, slot + line.top);
+                bottom = std::max(bottom, slot + line.bottom);
+            }
+        }
+        
+        *cropX = floor(left) - padding;
+        *cropY = floor(top) - padding;
+        *width = static_cast<int>(ceil(right) - floor(left)) + 2 * padding;
+        *height = static_cast<int>(ceil(bottom) - floor(top)) + 2 * padding;
+        return true;
+    }
+    
+    void setTajweed(bool enabled) {
+        tajweed = enabled;
+    }
+    
+    void setRenderSettings(const RenderSettings& settings) {
+        render = settings;
+    }
+    
+    RenderQueue* getRenderQueue() {
+        if (!renderQueue) {
+            renderQueue.reset(new RenderQueue());
+        }
+        return renderQueue.get();
+    }
+};
+
+// Long text laid out lazily for a viewport (see quran_text_document_create)
+struct QuranTextDocumentImpl {
+    // Word inside text; width is measured on first use
+    struct Word {
+        uint32_t start;
+        uint32_t end;
+        int width = -1;             // Font units
+        std::shared_ptr<ShapedText> shaped;  // Shaped on first unjustified draw
+    };
+    
+    struct Line {
+        uint32_t firstWord;
+        uint32_t wordCount;
+        int top;                    // Content y of the line box
+        bool justify;
+        std::shared_ptr<ShapedText> shaped;  // Justified lines only, shaped on first draw
+    };
+    
+    QuranRendererImpl* renderer;
+    std::string text;
+    QuranTextConfig config;
+    float spacing;
+    int fontSize;
+    int width = 0;
+    
+    std::vector<uint32_t> paragraphFirstWord;   // Index of each paragraph's first word
+    std::vector<Word> words;
+    int spaceWidth = 0;                         // Font units
+    
+    // Layout state for the current width
+    float marginLeft = 0;
+    float marginRight = 0;
+    double lineWidthUnits = 0;
+    int lineHeight = 0;
+    std::vector<Line> lines;
+    uint32_t nextParagraph = 0;                 // First paragraph not yet broken into lines
+    std::vector<size_t> shapedLines;            // Lines holding a shaped run
+    std::vector<uint32_t> shapedWords;          // Words holding a shaped run (kept across reflows)
+    
+    QuranTextDocumentImpl(QuranRendererImpl* r, const char* data, size_t length,
+                          const QuranTextConfig* cfg, float lineSpacing)
+        : renderer(r), text(data, length) {
+        if (cfg) {
+            config = *cfg;
+        } else {
+            // Same defaults quran_renderer_draw_text applies without a config
+            config = QuranTextConfig{};
+            config.backgroundColor = 0xFFFFFFFF;
+            config.rightToLeft = true;
+            config.tajweed = true;
+            config.marginLeft = -1.0f;
+            config.marginRight = -1.0f;
+        }
+        fontSize = config.fontSize > 0 ? config.fontSize : 48;
+        spacing = (lineSpacing > 0) ? lineSpacing : 1.5f;
+        
+        // Line height must accommodate Arabic marks above and below
+        lineHeight = static_cast<int>(static_cast<int>(fontSize * 1.2f) * spacing);
+        
+        splitWords();
+        spaceWidth = renderer->wordSpaceWidth(config.tajweed);
+    }
+    
+    double scale() const {
+        return static_cast<double>(fontSize) / renderer->upem;
+    }
+    
+    // Paragraphs at '\n', words at spaces and tabs (never mid-word)
+    void splitWords() {
+        uint32_t size = static_cast<uint32_t>(text.size());
+        uint32_t i = 0;
+        paragraphFirstWord.push_back(0);
+        
+        while (i < size) {
+            char c = text[i];
+            if (c == '\n') {
+                paragraphFirstWord.push_back(static_cast<uint32_t>(words.size()));
+                i++;
+            } else if (c == ' ' || c == '\t' || c == '\r') {
+                i++;
+            } else {
+                uint32_t start = i;
+                while (i < size && text[i] != ' ' && text[i] != '\t' && text[i] != '\r' && text[i] != '\n') {
+                    i++;
+                }
+                words.push_back({start, i});
+            }
+        }
+        paragraphFirstWord.push_back(static_cast<uint32_t>(words.size()));
+    }
+    
+    int wordWidth(Word& word) {
+        if (word.width < 0) {
+            word.width = renderer->advanceWidth(text.data() + word.start, word.end - word.start, config.tajweed);
+        }
+        return word.width;
+    }
+    
+    // Unjustified lines are painted word by word from these runs
+    const ShapedText& wordShape(uint32_t index) {
+        Word& word = words[index];
+        if (!word.shaped) {
+            shapedWords.push_back(index);
+            word.shaped = std::make_shared<ShapedText>();
+            renderer->shapeText(text.data() + word.start, word.end - word.start, 0, config.tajweed, word.shaped.get());
+        }
+        return *word.shaped;
+    }
+    
+    void setWidth(int newWidth) {
+        if (newWidth == width) return;
+        width = newWidth;
+        reflow();
+    }
+    
+    // Shapes and widths are in font units, so a size change only rebreaks
+    // lines; cached word runs are reused at the new size
+    void setFontSize(int newFontSize) {
+        if (newFontSize == fontSize) return;
+        fontSize = newFontSize;
+        lineHeight = static_cast<int>(static_cast<int>(fontSize * 1.2f) * spacing);
+        reflow();
+    }
+    
+    void reflow() {
+        // Same margin and line width rules as quran_renderer_draw_wrapped_text
+        marginLeft = config.marginLeft >= 0 ? config.marginLeft : std::max(10.0f, width * 0.05f);
+        marginRight = config.marginRight >= 0 ? config.marginRight : std::max(10.0f, width * 0.05f);
+        
+        float availableWidth = width - marginLeft - marginRight;
+        float maxLineWidth = config.lineWidth > 0 ? std::min(config.lineWidth, availableWidth) : availableWidth;
+        if (maxLineWidth <= 0) {
+            maxLineWidth = width * 0.9f;
+        }
+        lineWidthUnits = maxLineWidth / scale();
+        
+        // Word widths and shapes are independent of the width: only line breaks
+        // (and justified lines) are redone
+        lines.clear();
+        shapedLines.clear();
+        nextParagraph = 0;
+    }
+    
+    int topMargin() const {
+        return static_cast<int>(marginLeft);
+    }
+    
+    int nextLineTop() const {
+        return lines.empty() ? topMargin() : lines.back().top + lineHeight;
+    }
+    
+    // Greedy word wrap of one paragraph; an empty paragraph is one empty line
+    void breakParagraph(uint32_t paragraph) {
+        uint32_t first = paragraphFirstWord[paragraph];
+        uint32_t last = paragraphFirstWord[paragraph + 1];
+        
+        if (first == last) {
+            lines.push_back({first, 0, nextLineTop(), false, nullptr});
+            return;
+        }
+        
+        uint32_t lineStart = first;
+        double lineWidth = 0;
+        for (uint32_t w = first; w < last; w++) {
+            int advance = wordWidth(words[w]);
+            if (w > lineStart && lineWidth + spaceWidth + advance > lineWidthUnits) {
+                lines.push_back({lineStart, w - lineStart, nextLineTop(), config.justify, nullptr});
+                lineStart = w;
+                lineWidth = advance;
+            } else {
+                lineWidth += (w > lineStart ? spaceWidth : 0) + advance;
+            }
+        }
+        lines.push_back({lineStart, last - lineStart, nextLineTop(), false, nullptr});
+    }
+    
+    // Breaks paragraphs until the lines reach content y (INT_MAX = whole document)
+    void layoutUntil(int y) {
+        uint32_t paragraphCount = static_cast<uint32_t>(paragraphFirstWord.size() - 1);
+        while (nextParagraph < paragraphCount && nextLineTop() <= y) {
+            breakParagraph(nextParagraph++);
+        }
+    }
+    
+    int height() {
+        layoutUntil(INT_MAX);
+        return lines.empty() ? 0 : nextLineTop() + topMargin();
+    }
+    
+    int lineCount() {
+        layoutUntil(INT_MAX);
+        return static_cast<int>(lines.size());
+    }
+    
+    // Kashida justification stretches glyphs across the whole line, so a
+    // justified line is shaped as one run at the current line width
+    const ShapedText& shapedLine(size_t index) {
+        Line& line = lines[index];
+        if (!line.shaped) {
+            shapedLines.push_back(index);
+            line.shaped = std::make_shared<ShapedText>();
+            uint32_t start = words[line.firstWord].start;
+            uint32_t end = words[line.firstWord + line.wordCount - 1].end;
+            renderer->shapeText(text.data() + start, end - start, lineWidthUnits, config.tajweed, line.shaped.get());
+        }
+        return *line.shaped;
+    }
+    
+    int draw(QuranPixelBuffer* buffer, int scrollY) {
+        // Ink of a line extends about 2x fontSize below its top (see draw_wrapped_text)
+        const int inkHeight = fontSize * 2;
+        layoutUntil(scrollY + buffer->height);
+        
+        uint32_t bgColor = config.backgroundColor;
+        
+        SkColorType colorType = (buffer->format == QURAN_PIXEL_FORMAT_BGRA8888)
+            ? kBGRA_8888_SkColorType
+            : kRGBA_8888_SkColorType;
+        SkImageInfo imageInfo = SkImageInfo::Make(buffer->width, buffer->height, colorType, kPremul_SkAlphaType);
+        auto canvas = SkCanvas::MakeRasterDirect(imageInfo, buffer->pixels, buffer->stride);
+        
+        const bool recorded = renderer->beginFrame(canvas.get(), *buffer, bgColor, config.clearMode);
+        
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        paint.setStyle(SkPaint::kFill_Style);
+        
+        skia_context_t context{};
+        context.canvas = canvas.get();
+        context.paint = &paint;
+        const ColorTable& colors = renderer->resolveColors(bgColor, config.textColor);
+        hb_color_t hbTextColor = colors.text;
+        setContextColors(&context, colors);
+        context.use_foreground_override = !config.tajweed;
+        
+        // First line whose ink reaches the viewport
+        auto it = std::lower_bound(lines.begin(), lines.end(), scrollY - inkHeight,
+            [](const Line& line, int y) { return line.top <= y; });
+        
+        // Drop shaped runs of lines more than a viewport away
+        auto farAway = [&](size_t index) {
+            const Line& line = lines[index];
+            return line.top + inkHeight < scrollY - buffer->height || line.top > scrollY + 2 * buffer->height;
+        };
+        for (size_t index : shapedLines) {
+            if (farAway(index)) lines[index].shaped.reset();
+        }
+        shapedLines.erase(std::remove_if(shapedLines.begin(), shapedLines.end(), farAway), shapedLines.end());
+        
+        const double s = scale();
+        const int x_start = static_cast<int>(width - marginRight);
+        int drawn = 0;
+        uint32_t firstWord = UINT32_MAX;
+        uint32_t endWord = 0;
+        
+        for (; it != lines.end() && it->top < scrollY + buffer->height; ++it) {
+            if (it->wordCount == 0) continue;
+            
+            canvas->resetMatrix();
+            canvas->translate(x_start, it->top - scrollY + fontSize + 10);   // Baseline as in draw_text
+            canvas->scale(s, -s);
+            
+            if (it->justify) {
+                const ShapedText& shaped = shapedLine(static_cast<size_t>(it - lines.begin()));
+                renderer->paintGlyphs(&context, shaped, LineFit{}, hbTextColor, config.tajweed);
+            } else {
+                // Words separated by the space advance, right to left
+                for (uint32_t w = it->firstWord; w < it->firstWord + it->wordCount; w++) {
+                    const ShapedText& shaped = wordShape(w);
+                    canvas->save();
+                    renderer->paintGlyphs(&context, shaped, LineFit{}, hbTextColor, config.tajweed);
+                    canvas->restore();
+                    canvas->translate(-(wordWidth(words[w]) + spaceWidth), 0);
+                }
+                firstWord = std::min(firstWord, it->firstWord);
+                endWord = std::max(endWord, it->firstWord + it->wordCount);
+            }
+            drawn++;
+        }
+        
+        // Keep word runs within about a viewport's worth of words of the ones drawn
+        uint32_t slack = endWord > firstWord ? endWord - firstWord : 0;
+        auto farWord = [&](uint32_t index) {
+            return index + slack < firstWord || index >= endWord + slack;
+        };
+        for (uint32_t index : shapedWords) {
+            if (farWord(index)) words[index].shaped.reset();
+        }
+        shapedWords.erase(std::remove_if(shapedWords.begin(), shapedWords.end(), farWord), shapedWords.end());
+        
+        if (recorded) renderer->endFrame();
+        return drawn;
+    }
+};
+
+// The mushaf as one vertical strip of lines (see quran_scroll_strip_create)
+struct QuranScrollStripImpl {
+    // A line rendered on a transparent background, bleed pixels above and below its slot
+    struct LineImage {
+        int height;
+        std::vector<uint32_t> pixels;   // width x height, premultiplied
+    };
+    
+    static constexpr size_t kLineCacheBudget = 32 * 1024 * 1024;
+    
+    QuranRendererImpl* renderer;
+    QuranRenderConfig config;
+    int pageGap;
+    int width = 0;
+    
+    // Line-height index for the current width: slot top of every line in
+    // mushaf order (global line index), plus the end of the strip
+    PageLayout layout{};
+    int baselineOffset = 0;         // Baseline within a slot, as on a page
+    int bleed = 0;                  // Ink may reach this far outside the slot
+    std::vector<int> lineTops;
+    std::vector<int> pageFirstLine; // Global index of each page's first line, plus the total
+    
+    LruCache<int, LineImage> lineCache{kLineCacheBudget};
+    SkColorType cachedColorType = kRGBA_8888_SkColorType;
+    unsigned cachedThemeGeneration = 0;
+    
+    QuranScrollStripImpl(QuranRendererImpl* r, const QuranRenderConfig* cfg, int gap)
+        : renderer(r), pageGap(std::max(0, gap)) {
+        if (cfg) {
+            config = *cfg;
+        } else {
+            // Same defaults quran_renderer_draw_page applies without a config
+            config = QuranRenderConfig{};
+            config.tajweed = true;
+            config.justify = true;
+            config.fontScale = 1.0f;
+            config.backgroundColor = 0xFFFFFFFF;
+            config.topMarginLines = -1.0f;
+        }
+    }
+    
+    void setWidth(int newWidth) {
+        if (newWidth == width) return;
+        width = newWidth;
+        
+        // Without a page height the line spacing is the minimum that fits the
+        // font (the landscape case of computePageLayout); page 2 avoids the
+        // Fatiha offset, which the strip does not use
+        layout = renderer->computePageLayout(width, 0, 2);
+        baselineOffset = static_cast<int>(layout.inter_line * 0.72);
+        bleed = layout.inter_line / 2;
+        
+        lineTops.clear();
+        pageFirstLine.clear();
+        int y = 0;
+        for (int page = 0; page < 604; page++) {
+            if (page > 0) y += pageGap;
+            pageFirstLine.push_back(static_cast<int>(lineTops.size()));
+            for (size_t line = 0; line < renderer->pages[page].size(); line++) {
+                lineTops.push_back(y);
+                y += layout.inter_line;
+            }
+        }
+        pageFirstLine.push_back(static_cast<int>(lineTops.size()));
+        lineTops.push_back(y);
+        
+        lineCache.clear();
+    }
+    
+    int lineCount() const {
+        return static_cast<int>(lineTops.size()) - 1;
+    }
+    
+    int height() const {
+        return lineTops.back();
+    }
+    
+    int pageAt(int y) const {
+        if (y < 0 || y >= height()) return -1;
+        int line = static_cast<int>(std::upper_bound(lineTops.begin(), lineTops.end(), y) - lineTops.begin()) - 1;
+        return static_cast<int>(std::upper_bound(pageFirstLine.begin(), pageFirstLine.end(), line) - pageFirstLine.begin()) - 1;
+    }
+    
+    std::shared_ptr<const LineImage> lineImage(int globalLine) {
+        if (auto cached = lineCache.get(globalLine)) {
+            return cached;
+        }
+        
+        int page = static_cast<int>(std::upper_bound(pageFirstLine.begin(), pageFirstLine.end(), globalLine) - pageFirstLine.begin()) - 1;
+        int line = globalLine - pageFirstLine[page];
+        
+        auto image = std::make_shared<LineImage>();
+        image->height = layout.inter_line + 2 * bleed;
+        image->pixels.assign(static_cast<size_t>(width) * image->height, 0);
+        
+        SkImageInfo imageInfo = SkImageInfo::Make(width, image->height, cachedColorType, kPremul_SkAlphaType);
+        auto canvas = SkCanvas::MakeRasterDirect(imageInfo, image->pixels.data(), width * 4);
+        
+        // Same paint setup as drawPage, over a transparent background
+        uint32_t backgroundColor = config.backgroundColor;
+        const ColorTable& colors = renderer->resolveColors(backgroundColor);
+        hb_color_t textColor = colors.text;
+        
+        SkPaint paint;
+        paint.setAntiAlias(renderer->render.antiAlias);
+        paint.setStyle(SkPaint::kFill_Style);
+        paint.setColor(SkColorSetARGB(
+            hb_color_get_alpha(textColor),
+            hb_color_get_red(textColor),
+            hb_color_get_green(textColor),
+            hb_color_get_blue(textColor)
+        ));
+        
+        skia_context_t context{};
+        context.canvas = canvas.get();
+        context.paint = &paint;
+        setContextColors(&context, colors);
+        context.use_foreground_override = config.useForeground;
+        
+        // Move the line's page baseline to its place in the image
+        const LineBox box = renderer->computeLineBox(layout, page, line);
+        canvas->translate(0, bleed + baselineOffset - box.baseline);
+        renderer->drawPageLine(canvas.get(), &context, layout, width, page, line,
+                               config.justify, textColor, backgroundColor);
+        
+        lineCache.put(globalLine, image, image->pixels.size() * sizeof(uint32_t));
+        return image;
+    }
+    
+    // Source-over of a premultiplied line image onto the window
+    static void blendRow(uint8_t* dst, const uint32_t* src, int count) {
+        for (int x = 0; x < count; x++, dst += 4) {
+            uint32_t pixel = src[x];
+            if (pixel == 0) continue;
+            
+            const uint8_t* s = reinterpret_cast<const uint8_t*>(&src[x]);
+            uint32_t inverse = 255 - s[3];
+            if (inverse == 0) {
+                memcpy(dst, s, 4);
+                continue;
+            }
+            for (int c = 0; c < 4; c++) {
+                dst[c] = static_cast<uint8_t>(s[c] + (dst[c] * inverse + 127) / 255);
+            }
+        }
+    }
+    
+    int draw(QuranPixelBuffer* buffer, int y0) {
+        SkColorType colorType = (buffer->format == QURAN_PIXEL_FORMAT_BGRA8888)
+            ? kBGRA_8888_SkColorType
+            : kRGBA_8888_SkColorType;
+        if (colorType != cachedColorType || renderer->themeGeneration != cachedThemeGeneration) {
+            lineCache.clear();
+            cachedColorType = colorType;
+            cachedThemeGeneration = renderer->themeGeneration;
+        }
+        
+        SkImageInfo imageInfo = SkImageInfo::Make(buffer->width, buffer->height, colorType, kPremul_SkAlphaType);
+        auto canvas = SkCanvas::MakeRasterDirect(imageInfo, buffer->pixels, buffer->stride);
+        
+        const bool recorded = renderer->beginFrame(canvas.get(), *buffer, config.backgroundColor, config.clearMode);
+        SkIRect ink = SkIRect::MakeEmpty();
+        
+        renderer->setTajweed(config.tajweed);
+        renderer->setRenderSettings(renderSettings(config.quality));
+        
+        const int y1 = y0 + buffer->height;
+        const int columns = std::min(width, buffer->width);
+        const int count = lineCount();
+        int drawn = 0;
+        
+        // First line whose image (slot plus bleed) reaches the window
+        int line = static_cast<int>(std::upper_bound(lineTops.begin(), lineTops.begin() + count,
+                                                     y0 - layout.inter_line - bleed) - lineTops.begin());
+        for (; line < count && lineTops[line] - bleed < y1; line++) {
+            std::shared_ptr<const LineImage> image = lineImage(line);
+            
+            int top = lineTops[line] - bleed - y0;
+            int firstRow = std::max(0, -top);
+            int lastRow = std::min(image->height, buffer->height - top);
+            for (int row = firstRow; row < lastRow; row++) {
+                uint8_t* dst = static_cast<uint8_t*>(buffer->pixels) + static_cast<size_t>(top + row) * buffer->stride;
+                blendRow(dst, image->pixels.data() + static_cast<size_t>(row) * width, columns);
+            }
+            ink.join(SkIRect::MakeLTRB(0, top + firstRow, columns, top + lastRow));
+            drawn++;
+        }
+        
+        renderer->setRenderSettings(renderSettings(QURAN_QUALITY_DEFAULT));
+        if (recorded) renderer->endFrame(ink);
+        return drawn;
+    }
+};
+
+// Single line of text edited a keystroke at a time (see quran_text_input_create)
+struct QuranTextInputImpl {
+    struct Word {
+        uint32_t start;
+        uint32_t end;
+        uint32_t spacesBefore;
+        int width;                              // Font units
+        std::shared_ptr<ShapedText> shaped;
+    };
+    
+    QuranRendererImpl* renderer;
+    QuranTextConfig config;
+    std::string text;
+    std::vector<Word> words;
+    int spaceWidth = 0;                         // Font units
+    
+    // Buffer the current text was painted into; anything else repaints fully
+    void* pixels = nullptr;
+    int bufferWidth = 0;
+    int bufferHeight = 0;
+    int bufferStride = 0;
+    QuranPixelFormat bufferFormat = QURAN_PIXEL_FORMAT_RGBA8888;
+    unsigned themeGeneration = 0;
+    bool painted = false;
+    
+    QuranTextInputImpl(QuranRendererImpl* r, const QuranTextConfig* cfg) : renderer(r) {
+        if (cfg) {
+            config = *cfg;
+        } else {
+            // Same defaults quran_renderer_draw_text applies without a config
+            config = QuranTextConfig{};
+            config.backgroundColor = 0xFFFFFFFF;
+            config.rightToLeft = true;
+            config.tajweed = true;
+            config.marginLeft = -1.0f;
+            config.marginRight = -1.0f;
+        }
+        spaceWidth = renderer->wordSpaceWidth(config.tajweed);
+    }
+    
+    // Pen position (font units from the right edge) where word i starts
+    int wordOrigin(size_t index) const {
+        int pen = 0;
+        for (size_t i = 0; i < index; i++) {
+            pen += static_cast<int>(words[i].spacesBefore) * spaceWidth + words[i].width;
+        }
+        return pen + static_cast<int>(words[index].spacesBefore) * spaceWidth;
+    }
+    
+    int totalAdvance() const {
+        return words.empty() ? 0 : wordOrigin(words.size() - 1) + words.back().width;
+    }
+    
+    // Splits text from byte offset `from` into words, shaping each one
+    void appendWords(uint32_t from) {
+        uint32_t size = static_cast<uint32_t>(text.size());
+        uint32_t i = from;
+        while (i < size) {
+            uint32_t spaces = 0;
+            while (i < size && text[i] == ' ') {
+                spaces++;
+                i++;
+            }
+            if (i == size) break;
+            
+            uint32_t start = i;
+            while (i < size && text[i] != ' ') {
+                i++;
+            }
+            
+            Word word{start, i, spaces, 0, std::make_shared<ShapedText>()};
+            renderer->shapeText(text.data() + start, i - start, 0, config.tajweed, word.shaped.get());
+            for (unsigned g = 0; g < word.shaped->count; g++) {
+                word.width += word.shaped->pos[g].x_advance;
+            }
+            words.push_back(std::move(word));
+        }
+    }
+    
+    int update(QuranPixelBuffer* buffer, const char* data, size_t length, QuranRect* dirty) {
+        bool full = !painted || buffer->pixels != pixels || buffer->width != bufferWidth ||
+                    buffer->height != bufferHeight || buffer->stride != bufferStride ||
+                    buffer->format != bufferFormat || renderer->themeGeneration != themeGeneration;
+        
+        // Joining never crosses a space, so words ending before the first
+        // changed byte (with their following space unchanged) keep their shapes
+        size_t common = 0;
+        size_t limit = std::min(text.size(), length);
+        while (common < limit && text[common] == data[common]) {
+            common++;
+        }
+        bool unchanged = (common == text.size() && common == length);
+        
+        size_t keep = 0;
+        while (keep < words.size() && words[keep].end < common) {
+            keep++;
+        }
+        
+        const int oldAdvance = totalAdvance();
+        const int stableAdvance = keep > 0 ? wordOrigin(keep - 1) + words[keep - 1].width : 0;
+        
+        if (!unchanged) {
+            text.assign(data, length);
+            words.resize(keep);
+            appendWords(keep > 0 ? words[keep - 1].end : 0);
+        }
+        const int newAdvance = totalAdvance();
+        
+        // Same layout as quran_renderer_draw_text
+        int fontSize = config.fontSize;
+        if (fontSize <= 0) {
+            fontSize = static_cast<int>((buffer->width / 17.0f) * 0.9f);
+            if (fontSize < 12) fontSize = 12;
+        }
+        const double scale = static_cast<double>(fontSize) / renderer->upem;
+        float marginRight = config.marginRight >= 0 ? config.marginRight : std::max(10.0f, buffer->width * 0.05f);
+        const int x_start = static_cast<int>(buffer->width - marginRight);
+        const int y_start = fontSize + 10;
+        
+        // Marks and swashes may reach past a word's advance box
+        const int overhang = fontSize;
+        
+        int left = 0;
+        int right = buffer->width;
+        if (!full) {
+            if (unchanged) {
+                if (dirty) *dirty = QuranRect{0, 0, 0, 0};
+                return static_cast<int>(newAdvance * scale);
+            }
+            left = std::max(0, static_cast<int>(x_start - std::max(oldAdvance, newAdvance) * scale) - overhang);
+            right = std::min(buffer->width, static_cast<int>(x_start - stableAdvance * scale) + overhang);
+        }
+        
+        SkColorType colorType = (buffer->format == QURAN_PIXEL_FORMAT_BGRA8888)
+            ? kBGRA_8888_SkColorType
+            : kRGBA_8888_SkColorType;
+        SkImageInfo imageInfo = SkImageInfo::Make(buffer->width, buffer->height, colorType, kPremul_SkAlphaType);
+        auto canvas = SkCanvas::MakeRasterDirect(imageInfo, buffer->pixels, buffer->stride);
+        canvas->clipRect(SkRect::MakeLTRB(left, 0, right, buffer->height));
+        
+        // Input clears its own changed region and leaves the rest in place
+        renderer->forgetFrame(*buffer);
+        uint32_t bgColor = config.backgroundColor;
+        
+        uint8_t bg_r = (bgColor >> 24) & 0xFF;
+        uint8_t bg_g = (bgColor >> 16) & 0xFF;
+        uint8_t bg_b = (bgColor >> 8) & 0xFF;
+        uint8_t bg_a = bgColor & 0xFF;
+        canvas->drawColor(SkColorSetARGB(bg_a, bg_r, bg_g, bg_b));
+        
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        paint.setStyle(SkPaint::kFill_Style);
+        
+        skia_context_t context{};
+        context.canvas = canvas.get();
+        context.paint = &paint;
+        const ColorTable& colors = renderer->resolveColors(bgColor, config.textColor);
+        hb_color_t hbTextColor = colors.text;
+        setContextColors(&context, colors);
+        context.use_foreground_override = !config.tajweed;
+        
+        // Repaint every word whose ink may reach the cleared region, including
+        // stable neighbours whose marks overhang into it
+        int pen = 0;
+        for (const Word& word : words) {
+            pen += static_cast<int>(word.spacesBefore) * spaceWidth;
+            int wordRight = static_cast<int>(x_start - pen * scale);
+            int wordLeft = static_cast<int>(x_start - (pen + word.width) * scale);
+            if (wordLeft - overhang < right && wordRight + overhang > left) {
+                canvas->resetMatrix();
+                canvas->translate(x_start, y_start);
+                canvas->scale(scale, -scale);
+                canvas->translate(-pen, 0);
+                renderer->paintGlyphs(&context, *word.shaped, LineFit{}, hbTextColor, config.tajweed);
+            }
+            pen += word.width;
+        }
+        
+        pixels = buffer->pixels;
+        bufferWidth = buffer->width;
+        bufferHeight = buffer->height;
+        bufferStride = buffer->stride;
+        bufferFormat = buffer->format;
+        themeGeneration = renderer->themeGeneration;
+        painted = true;
+        
+        if (dirty) *dirty = QuranRect{left, 0, right - left, buffer->height};
+        return static_cast<int>(newAdvance * scale);
+    }
+};
+
+// C API Implementation
+
+extern "C" {
+
+QuranRendererHandle quran_renderer_create(const QuranFontData* fontData) {
+    if (!fontData || !fontData->data || fontData->size == 0) {
+        return nullptr;
+    }
+    
+    auto renderer = new QuranRendererImpl();
+    if (!renderer->initialize(fontData->data, fontData->size)) {
+        delete renderer;
+        return nullptr;
+    }
+    
+    return renderer;
+}
+
+void quran_renderer_destroy(QuranRendererHandle renderer) {
+    delete renderer;
+}
+
+bool quran_renderer_load_surah_header_font(QuranRendererHandle renderer, const QuranFontData* fontData) {
+    if (!renderer || !fontData || !fontData->data || fontData->size == 0) {
+        return false;
+    }
+    
+    return renderer->loadSurahHeaderFontFromData(fontData->data, fontData->size);
+}
+
+void quran_renderer_draw_page(
+    QuranRendererHandle renderer,
+    QuranPixelBuffer* buffer,
+    int pageIndex,
+    const QuranRenderConfig* config
+) {
+    quran_renderer_draw_page_phase(renderer, buffer, pageIndex, config, QURAN_RENDER_FINAL);
+}
+
+QuranRenderPhase quran_renderer_draw_page_phase(
+    QuranRendererHandle renderer,
+    QuranPixelBuffer* buffer,
+    int pageIndex,
+    const QuranRenderConfig* config,
+    QuranRenderPhase phase
+) {
+    if (!renderer || !buffer || !buffer->pixels) return QURAN_RENDER_FINAL;
+    if (pageIndex < 0 || pageIndex >= 604) return QURAN_RENDER_FINAL;
+    
+    // Without kashida shaping fitLine still stretches the spaces of justified
+    // lines to the line width, which is the preview. With justify off the
+    // preview is the final frame.
+    const bool justify = config ? config->justify : true;
+    const bool kashida = justify && phase == QURAN_RENDER_FINAL;
+    const bool draft = phase == QURAN_RENDER_DRAFT;
+    
+    renderer->setTajweed(config ? config->tajweed : true);
+    renderer->setRenderSettings(draft ? kDraftSettings
+                                      : renderSettings(config ? config->quality : QURAN_QUALITY_DEFAULT));
+    renderer->drawPage(
+        buffer->pixels,
+        buffer->width,
+        buffer->height,
+        buffer->stride,
+        pageIndex,
+        kashida,
+        config ? config->fontScale : 1.0f,
+        config ? config->backgroundColor : 0xFFFFFFFF,
+        config ? config->fontSize : 0,
+        config ? config->useForeground : false,
+        config ? config->lineHeightDivisor : 0.0f,
+        config ? config->topMarginLines : -1.0f,
+        buffer->format,  // Pass pixel format through to renderer
+        config ? config->clearMode : QURAN_CLEAR_FULL
+    );
+    renderer->setRenderSettings(renderSettings(QURAN_QUALITY_DEFAULT));
+    
+    if (draft) return QURAN_RENDER_DRAFT;
+    return (justify && !kashida) ? QURAN_RENDER_PREVIEW : QURAN_RENDER_FINAL;
+}
+
+void quran_renderer_forget_buffer(QuranRendererHandle renderer, const QuranPixelBuffer* buffer) {
+    if (!renderer) return;
+    
+    if (buffer) {
+        renderer->forgetFrame(*buffer);
+    } else {
+        renderer->lastFrame.pixels = nullptr;
+    }
+}
+
+void quran_renderer_draw_spread(
+    QuranRendererHandle renderer,
+    QuranPixelBuffer* buffer,
+    int rightPage,
+    const QuranRenderConfig* config
+) {
+    if (!renderer || !buffer || !buffer->pixels) return;
+    if (rightPage < 0 || rightPage >= 604) return;
+    
+    renderer->setRenderSettings(renderSettings(config ? config->quality : QURAN_QUALITY_DEFAULT));
+    renderer->drawSpread(buffer, rightPage, config);
+    renderer->setRenderSettings(renderSettings(QURAN_QUALITY_DEFAULT));
+}
+
+// ============================================================================
+// Ayah Image API Implementation
+// ============================================================================
+
+static bool validAyahRange(int surahNumber, int firstAyah, int lastAyah) {
+    return surahNumber >= 1 && surahNumber <= QURAN_SURAH_COUNT &&
+           firstAyah >= 1 && firstAyah <= lastAyah && lastAyah <= SURAH_DATA[surahNumber].ayahCount;
+}
+
+bool quran_renderer_measure_ayah_image(
+    QuranRendererHandle renderer,
+    int surahNumber,
+    int firstAyah,
+    int lastAyah,
+    int pageWidth,
+    int padding,
+    const QuranRenderConfig* config,
+    int* outWidth,
+    int* outHeight
+) {
+    if (!renderer || pageWidth <= 0 || padding < 0) return false;
+    if (!validAyahRange(surahNumber, firstAyah, lastAyah)) return false;
+    
+    std::vector<AyahImageLine> lines;
+    PageLayout layout;
+    double cropX, cropY;
+    int width, height;
+    if (!renderer->layoutAyahImage(surahNumber, firstAyah, lastAyah, pageWidth, padding,
+                                   config ? config->justify : true, config ? config->tajweed : true,
+                                   &lines, &layout, &cropX, &cropY, &width, &height)) {
+        return false;
+    }
+    
+    if (outWidth) *outWidth = width;
+    if (outHeight) *outHeight = height;
+    return true;
+}
+
+bool quran_renderer_draw_ayah_image(
+    QuranRendererHandle renderer,
+    QuranPixelBuffer* buffer,
+    int surahNumber,
+    int firstAyah,
+    int lastAyah,
+    int pageWidth,
+    int padding,
+    const QuranRenderConfig* config
+) {
+    if (!renderer || !buffer || !buffer->pixels || pageWidth <= 0 || padding < 0) return false;
+    if (!validAyahRange(surahNumber, firstAyah, lastAyah)) return false;
+    
+    const bool useTajweed = config ? config->tajweed : true;
+    const uint32_t backgroundColor = config ? config->backgroundColor : 0xFFFFFFFF;
+    
+    std::vector<AyahImageLine> lines;
+    PageLayout layout;
+    double cropX, cropY;
+    int width, height;
+    if (!renderer->layoutAyahImage(surahNumber, firstAyah, lastAyah, pageWidth, padding,
+                                   config ? config->justify : true, useTajweed,
+                                   &lines, &layout, &cropX, &cropY, &width, &height)) {
+        return false;
+    }
+    
+    SkColorType colorType = (buffer->format == QURAN_PIXEL_FORMAT_BGRA8888)
+        ? kBGRA_8888_SkColorType
+        : kRGBA_8888_SkColorType;
+    SkImageInfo imageInfo = SkImageInfo::Make(buffer->width, buffer->height, colorType, kPremul_SkAlphaType);
+    auto canvas = SkCanvas::MakeRasterDirect(imageInfo, buffer->pixels, buffer->stride);
+    
+    const bool recorded = renderer->beginFrame(canvas.get(), *buffer, backgroundColor,
+                                               config ? config->clearMode : QURAN_CLEAR_FULL);
+    
+    // Same paint setup as drawPage
+    renderer->setRenderSettings(renderSettings(config ? config->quality : QURAN_QUALITY_DEFAULT));
+    const ColorTable& colors = renderer->resolveColors(backgroundColor);
+    hb_color_t textColor = colors.text;
+    SkPaint paint;
+    paint.setAntiAlias(renderer->render.antiAlias);
+    paint.setStyle(SkPaint::kFill_Style);
+    paint.setColor(SkColorSetARGB(
+        hb_color_get_alpha(textColor),
+        hb_color_get_red(textColor),
+        hb_color_get_green(textColor),
+        hb_color_get_blue(textColor)
+    ));
+    
+    skia_context_t context{};
+    context.canvas = canvas.get();
+    context.paint = &paint;
+    setContextColors(&context, colors);
+    context.use_foreground_override = config ? config->useForeground : false;
+    
+    // Center the crop if the buffer is larger than measured
+    const double offsetX = std::max(0, buffer->width - width) / 2.0 - cropX;
+    const double offsetY = std::max(0, buffer->height - height) / 2.0 - cropY;
+    
+    // Only the glyphs of the ayahs' clusters are rasterized
+    for (size_t i = 0; i < lines.size(); i++) {
+        const AyahImageLine& line = lines[i];
+        canvas->resetMatrix();
+        canvas->translate(line.box.originX + offsetX, i * layout.inter_line + offsetY);
+        canvas->scale(layout.scale, -layout.scale);
+        if (line.fit.ratio != 1.0) {
+            canvas->scale(line.fit.ratio, line.fit.ratio);
         }
+        canvas->translate(line.fit.startX, 0);
+        renderer->paintGlyphs(&context, *line.shaped, line.fit, textColor, useTajweed,
+                              line.byteStart, line.byteEnd);
     }
     
-    void setTajweed(bool enabled) {
-        tajweed = enabled;
+    if (recorded) renderer->endFrame();
+    renderer->setRenderSettings(renderSettings(QURAN_QUALITY_DEFAULT));
+    return true;
+}
+
+int quran_renderer_prepare_justification(
+    QuranRendererHandle renderer,
+    int firstPage,
+    int lastPage,
+    int width,
+    const QuranRenderConfig* config
+) {
+    if (!renderer || width < 0) return -1;
+    if (firstPage < 0 || lastPage >= 604 || firstPage > lastPage) return -1;
+    
+    const bool useTajweed = config ? config->tajweed : true;
+    const bool justify = config ? config->justify : true;
+    
+    if (width > 0) {
+        return renderer->prepareLines(firstPage, lastPage, &width, 1, justify, useTajweed);
     }
-};
+    return renderer->prepareLines(firstPage, lastPage, kCommonPageWidths,
+                                  sizeof(kCommonPageWidths) / sizeof(kCommonPageWidths[0]), justify, useTajweed);
+}
 
-// C API Implementation
+int quran_renderer_get_page_count(QuranRendererHandle renderer) {
+    return renderer ? 604 : 0;
+}
 
-extern "C" {
+// ============================================================================
+// Asynchronous Rendering
+// ============================================================================
 
-QuranRendererHandle quran_renderer_create(const QuranFontData* fontData) {
-    if (!fontData || !fontData->data || fontData->size == 0) {
-        return nullptr;
-    }
+bool quran_renderer_draw_page_async(
+    QuranRendererHandle renderer,
+    const QuranPixelBuffer* buffer,
+    int pageIndex,
+    const QuranRenderConfig* config,
+    bool progressive,
+    QuranRenderCallback callback,
+    void* userData
+) {
+    if (!renderer || !buffer || !buffer->pixels) return false;
+    if (pageIndex < 0 || pageIndex >= 604) return false;
     
-    auto renderer = new QuranRendererImpl();
-    if (!renderer->initialize(fontData->data, fontData->size)) {
-        delete renderer;
-        return nullptr;
+    RenderQueue* queue;
+    try {
+        queue = renderer->getRenderQueue();
+    } catch (const std::system_error&) {
+        return false;
     }
     
-    return renderer;
+    // Each pass is its own job so cancelling can drop the final pass of a
+    // page that was scrolled past after its draft
+    QuranPixelBuffer target = *buffer;
+    const bool hasConfig = config != nullptr;
+    QuranRenderConfig settings = hasConfig ? *config : QuranRenderConfig{};
+    auto pass = [=](QuranRenderPhase phase) {
+        QuranPixelBuffer pixels = target;
+        QuranRenderPhase drawn = quran_renderer_draw_page_phase(
+            renderer, &pixels, pageIndex, hasConfig ? &settings : nullptr, phase);
+        if (callback) callback(userData, pageIndex, drawn);
+    };
+    
+    if (progressive) {
+        queue->push([=] { pass(QURAN_RENDER_DRAFT); });
+    }
+    queue->push([=] { pass(QURAN_RENDER_FINAL); });
+    return true;
 }
 
-void quran_renderer_destroy(QuranRendererHandle renderer) {
-    delete renderer;
+void quran_renderer_cancel_async(QuranRendererHandle renderer) {
+    if (!renderer || !renderer->renderQueue) return;
+    renderer->renderQueue->cancel();
 }
 
-bool quran_renderer_load_surah_header_font(QuranRendererHandle renderer, const QuranFontData* fontData) {
-    if (!renderer || !fontData || !fontData->data || fontData->size == 0) {
-        return false;
+void quran_renderer_wait_async(QuranRendererHandle renderer) {
+    if (!renderer || !renderer->renderQueue) return;
+    renderer->renderQueue->wait();
+}
+
+// ============================================================================
+// Color Themes Implementation
+// ============================================================================
+
+bool quran_renderer_get_builtin_theme(QuranThemeStyle style, QuranTheme* theme) {
+    if (!theme) return false;
+    
+    // Tajweed colors in QuranTajweedColor order
+    switch (style) {
+        case QURAN_THEME_LIGHT:
+            *theme = QuranTheme{0xFFFFFFFF, 0, {}};
+            return true;
+        case QURAN_THEME_SEPIA:
+            *theme = QuranTheme{0xF4ECD8FF, 0x3B2A1AFF, {
+                0x2E7D32FF, 0x1A3A6BFF, 0x9E8E7AFF, 0x1E88A8FF,
+                0xB8860BFF, 0xD2691EFF, 0xC62828FF, 0x7B1010FF}};
+            return true;
+        case QURAN_THEME_NIGHT:
+            *theme = QuranTheme{0x000000FF, 0xE8E8E8FF, {
+                0x66D18FFF, 0x7FA7FFFF, 0x8A8A8AFF, 0x6FD3FFFF,
+                0xF0C75EFF, 0xFFA552FF, 0xFF6B6BFF, 0xFF3D7FFF}};
+            return true;
+        case QURAN_THEME_HIGH_CONTRAST:
+            *theme = QuranTheme{0xFFFFFFFF, 0x000000FF, {
+                0x008000FF, 0x0000CCFF, 0x808080FF, 0x00A0E0FF,
+                0xE0A000FF, 0xFF6000FF, 0xFF0000FF, 0x990000FF}};
+            return true;
     }
+    return false;
+}
+
+void quran_renderer_set_theme(QuranRendererHandle renderer, const QuranTheme* theme) {
+    if (!renderer) return;
+    renderer->setTheme(theme);
+}
+
+// ============================================================================
+// Page Metrics API Implementation
+// ============================================================================
+
+int quran_renderer_get_page_metrics(
+    QuranRendererHandle renderer,
+    int pageIndex,
+    int width,
+    int height,
+    const QuranRenderConfig* config,
+    QuranPageMetrics* metrics,
+    QuranLineMetrics* lines,
+    int maxLines
+) {
+    (void)config;  // Page layout does not depend on config yet
     
-    return renderer->loadSurahHeaderFontFromData(fontData->data, fontData->size);
+    if (!renderer || width <= 0 || height <= 0) return -1;
+    if (pageIndex < 0 || pageIndex >= 604) return -1;
+    
+    return renderer->getPageMetrics(pageIndex, width, height, metrics, lines, maxLines);
 }
 
-void quran_renderer_draw_page(
+// ============================================================================
+// Text Selection API Implementation
+// ============================================================================
+
+int quran_renderer_get_line_clusters(
     QuranRendererHandle renderer,
-    QuranPixelBuffer* buffer,
     int pageIndex,
-    const QuranRenderConfig* config
+    int lineIndex,
+    int width,
+    int height,
+    const QuranRenderConfig* config,
+    QuranCluster* clusters,
+    int maxClusters
 ) {
-    if (!renderer || !buffer || !buffer->pixels) return;
-    if (pageIndex < 0 || pageIndex >= 604) return;
+    if (!renderer || width <= 0 || height <= 0) return -1;
+    if (pageIndex < 0 || pageIndex >= 604) return -1;
     
-    renderer->setTajweed(config ? config->tajweed : true);
-    renderer->drawPage(
-        buffer->pixels,
-        buffer->width,
-        buffer->height,
-        buffer->stride,
-        pageIndex,
-        config ? config->justify : true,
-        config ? config->fontScale : 1.0f,
-        config ? config->backgroundColor : 0xFFFFFFFF,
-        config ? config->fontSize : 0,
-        config ? config->useForeground : false,
-        config ? config->lineHeightDivisor : 0.0f,
-        config ? config->topMarginLines : -1.0f,
-        buffer->format  // Pass pixel format through to renderer
-    );
+    return renderer->getLineClusters(pageIndex, lineIndex, width, height,
+                                     config ? config->justify : true,
+                                     config ? config->tajweed : true,
+                                     clusters, maxClusters);
 }
 
-int quran_renderer_get_page_count(QuranRendererHandle renderer) {
-    return renderer ? 604 : 0;
+int quran_renderer_get_text_clusters(
+    QuranRendererHandle renderer,
+    const char* text,
+    int textLength,
+    int fontSize,
+    QuranCluster* clusters,
+    int maxClusters
+) {
+    if (!renderer || !text || fontSize <= 0) {
+        return -1;
+    }
+    
+    size_t len = (textLength < 0) ? strlen(text) : static_cast<size_t>(textLength);
+    if (len == 0) {
+        return 0;
+    }
+    
+    // Shaped exactly like quran_renderer_measure_text
+    ShapedText shaped;
+    renderer->shapeText(text, len, 0, true, &shaped);
+    
+    std::vector<ClusterExtent> extents;
+    collectClusters(shaped, LineFit{}, static_cast<uint32_t>(len), &extents);
+    
+    // Pen positions run leftwards from 0; shift so the text spans [0, width]
+    double totalWidth = 0;
+    for (unsigned int i = 0; i < shaped.count; i++) {
+        totalWidth += shaped.pos[i].x_advance;
+    }
+    double scale = static_cast<double>(fontSize) / renderer->upem;
+    
+    int count = static_cast<int>(extents.size());
+    for (int k = 0; k < count && clusters && k < maxClusters; k++) {
+        clusters[k].byteStart = static_cast<int>(extents[k].byteStart);
+        clusters[k].byteEnd = static_cast<int>(extents[k].byteEnd);
+        clusters[k].left = static_cast<float>((totalWidth + extents[k].left) * scale);
+        clusters[k].right = static_cast<float>((totalWidth + extents[k].right) * scale);
+    }
+    
+    return count;
 }
 
 // ============================================================================
@@ -921,34 +3350,270 @@ int quran_renderer_get_ayah_page(int surahNumber, int ayahNumber) {
         }
     }
     
-    return 0;  // Default to first page
+    return 0;  // Default to first page
+}
+
+bool quran_renderer_get_page_location(int pageIndex, QuranAyahLocation* location) {
+    if (pageIndex < 0 || pageIndex >= QURAN_PAGE_COUNT || !location) {
+        return false;
+    }
+    
+    const PageLocation& loc = PAGE_LOCATIONS[pageIndex];
+    location->surahNumber = loc.surahNumber;
+    location->ayahNumber = loc.ayahNumber;
+    location->pageIndex = pageIndex;
+    
+    return true;
+}
+
+int quran_renderer_get_ayah_count(int surahNumber) {
+    if (surahNumber < 1 || surahNumber > 114) {
+        return -1;
+    }
+    
+    return SURAH_DATA[surahNumber].ayahCount;
+}
+
+// ============================================================================
+// Juz/Hizb API Implementation
+// ============================================================================
+
+static bool getRubLocation(int rubIndex, QuranAyahLocation* location) {
+    if (rubIndex < 0 || rubIndex >= QURAN_RUB_COUNT || !location) {
+        return false;
+    }
+
+    const RubLocation& rub = RUB_LOCATIONS[rubIndex];
+    location->surahNumber = rub.surahNumber;
+    location->ayahNumber = rub.ayahNumber;
+    location->pageIndex = rub.pageIndex;
+
+    return true;
+}
+
+bool quran_renderer_get_juz_location(int juzNumber, QuranAyahLocation* location) {
+    if (juzNumber < 1 || juzNumber > QURAN_JUZ_COUNT) {
+        return false;
+    }
+    return getRubLocation((juzNumber - 1) * 8, location);
+}
+
+bool quran_renderer_get_hizb_location(int hizbNumber, QuranAyahLocation* location) {
+    if (hizbNumber < 1 || hizbNumber > QURAN_HIZB_COUNT) {
+        return false;
+    }
+    return getRubLocation((hizbNumber - 1) * 4, location);
+}
+
+bool quran_renderer_get_rub_location(int rubNumber, QuranAyahLocation* location) {
+    return getRubLocation(rubNumber - 1, location);
+}
+
+int quran_renderer_get_juz_start_page(int juzNumber) {
+    if (juzNumber < 1 || juzNumber > QURAN_JUZ_COUNT) {
+        return -1;
+    }
+    return RUB_LOCATIONS[(juzNumber - 1) * 8].pageIndex;
+}
+
+int quran_renderer_get_page_juz(int pageIndex) {
+    if (pageIndex < 0 || pageIndex >= QURAN_PAGE_COUNT) {
+        return -1;
+    }
+    return PAGE_RUBS[pageIndex] / 8 + 1;
+}
+
+int quran_renderer_get_page_hizb(int pageIndex) {
+    if (pageIndex < 0 || pageIndex >= QURAN_PAGE_COUNT) {
+        return -1;
+    }
+    return PAGE_RUBS[pageIndex] / 4 + 1;
+}
+
+int quran_renderer_get_page_rub(int pageIndex) {
+    if (pageIndex < 0 || pageIndex >= QURAN_PAGE_COUNT) {
+        return -1;
+    }
+    return PAGE_RUBS[pageIndex] + 1;
+}
+
+// ============================================================================
+// Ayah Text API Implementation
+// ============================================================================
+
+int quran_renderer_get_ayah_spans(
+    int surahNumber,
+    int ayahNumber,
+    QuranTextSpan* spans,
+    int maxSpans
+) {
+    const QuranTextIndex& textIndex = QuranTextIndex::get();
+    
+    std::vector<QuranLineRange> ranges;
+    int count = textIndex.ayahLineRanges(surahNumber, ayahNumber, &ranges);
+    if (count == 0) {
+        return -1;
+    }
+    
+    for (int i = 0; spans && i < count && i < maxSpans; i++) {
+        const QuranPageText& page = textIndex.pages[ranges[i].pageIndex];
+        const QuranTextLine& line = page.lines[ranges[i].lineIndex];
+        spans[i].text = page.text + ranges[i].start;
+        spans[i].length = static_cast<int>(ranges[i].end - ranges[i].start);
+        spans[i].pageIndex = ranges[i].pageIndex;
+        spans[i].lineIndex = ranges[i].lineIndex;
+        spans[i].byteStart = static_cast<int>(ranges[i].start - line.start);
+    }
+    
+    return count;
+}
+
+int quran_renderer_get_ayah_text(
+    int surahNumber,
+    int ayahNumber,
+    char* buffer,
+    int bufferSize
+) {
+    const QuranTextIndex& textIndex = QuranTextIndex::get();
+    
+    std::vector<QuranLineRange> ranges;
+    int count = textIndex.ayahLineRanges(surahNumber, ayahNumber, &ranges);
+    if (count == 0) {
+        return -1;
+    }
+    
+    int length = 0;
+    int written = 0;
+    int capacity = (buffer && bufferSize > 0) ? bufferSize - 1 : 0;
+    
+    for (int i = 0; i < count; i++) {
+        const char* text = textIndex.pages[ranges[i].pageIndex].text + ranges[i].start;
+        int rangeLength = static_cast<int>(ranges[i].end - ranges[i].start);
+        
+        if (i > 0) {
+            if (written < capacity) buffer[written++] = ' ';
+            length++;
+        }
+        
+        int copy = std::min(rangeLength, capacity - written);
+        if (copy > 0) {
+            memcpy(buffer + written, text, copy);
+            written += copy;
+        }
+        length += rangeLength;
+    }
+    
+    if (buffer && bufferSize > 0) {
+        buffer[written] = '\0';
+    }
+    
+    return length;
+}
+
+// ============================================================================
+// Search API Implementation
+// ============================================================================
+
+bool quran_renderer_prepare_search_index(void) {
+    return !QuranSearchIndex::get().suffixArray.empty();
+}
+
+int quran_renderer_search(
+    const char* query,
+    int queryLength,
+    QuranSearchHit* hits,
+    int maxHits
+) {
+    if (!query) {
+        return -1;
+    }
+    
+    size_t len = (queryLength < 0) ? strlen(query) : static_cast<size_t>(queryLength);
+    
+    std::vector<QuranSearchMatch> matches;
+    int total = QuranSearchIndex::get().search(query, len, hits ? maxHits : 0, &matches);
+    
+    for (size_t i = 0; i < matches.size(); i++) {
+        hits[i].pageIndex = matches[i].pageIndex;
+        hits[i].lineIndex = matches[i].lineIndex;
+        hits[i].byteStart = matches[i].byteStart;
+        hits[i].byteEnd = matches[i].byteEnd;
+        hits[i].surahNumber = matches[i].surahNumber;
+        hits[i].ayahNumber = matches[i].ayahNumber;
+    }
+    
+    return total;
+}
+
+// ============================================================================
+// Generic Arabic Text Rendering Implementation
+// ============================================================================
+
+// Helper: split UTF-8 string by spaces while preserving Arabic text integrity
+static std::vector<std::string> splitIntoWords(const char* text, size_t len) {
+    std::vector<std::string> words;
+    std::string current;
+    
+    for (size_t i = 0; i < len; ) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        
+        // Check for space (ASCII space or Arabic space)
+        if (c == ' ' || c == '\t') {
+            if (!current.empty()) {
+                words.push_back(current);
+                current.clear();
+            }
+            i++;
+        } else {
+            // UTF-8 character: determine byte count
+            int charBytes = 1;
+            if ((c & 0xF8) == 0xF0) charBytes = 4;      // 4-byte UTF-8
+            else if ((c & 0xF0) == 0xE0) charBytes = 3; // 3-byte UTF-8
+            else if ((c & 0xE0) == 0xC0) charBytes = 2; // 2-byte UTF-8
+            
+            // Append full UTF-8 character
+            for (int j = 0; j < charBytes && i + j < len; j++) {
+                current += text[i + j];
+            }
+            i += charBytes;
+        }
+    }
+    
+    if (!current.empty()) {
+        words.push_back(current);
+    }
+    
+    return words;
 }
 
-bool quran_renderer_get_page_location(int pageIndex, QuranAyahLocation* location) {
-    if (pageIndex < 0 || pageIndex >= QURAN_PAGE_COUNT || !location) {
-        return false;
+// Word advances in font units, as both wrapping functions measure them
+static std::vector<int> measureWords(QuranRendererHandle renderer, const std::vector<std::string>& words) {
+    std::vector<int> widths;
+    widths.reserve(words.size());
+    for (const std::string& word : words) {
+        widths.push_back(renderer->advanceWidth(word.c_str(), word.length(), true));
     }
-    
-    const PageLocation& loc = PAGE_LOCATIONS[pageIndex];
-    location->surahNumber = loc.surahNumber;
-    location->ayahNumber = loc.ayahNumber;
-    location->pageIndex = pageIndex;
-    
-    return true;
+    return widths;
 }
 
-int quran_renderer_get_ayah_count(int surahNumber) {
-    if (surahNumber < 1 || surahNumber > 114) {
-        return -1;
+// Greedy word wrap shared by draw_wrapped_text and fit_text_size. Widths are
+// in font units, so the size fit_text_size picks wraps into the lines it
+// counted. Returns the first word of each line; a word wider than the line
+// gets a line of its own.
+static std::vector<size_t> wrapWords(const std::vector<int>& wordWidths, int spaceWidth, double lineWidth) {
+    std::vector<size_t> lineStarts;
+    double current = 0;
+    for (size_t w = 0; w < wordWidths.size(); w++) {
+        if (lineStarts.empty() || current + spaceWidth + wordWidths[w] > lineWidth) {
+            lineStarts.push_back(w);
+            current = wordWidths[w];
+        } else {
+            current += spaceWidth + wordWidths[w];
+        }
     }
-    
-    return SURAH_DATA[surahNumber].ayahCount;
+    return lineStarts;
 }
 
-// ============================================================================
-// Generic Arabic Text Rendering Implementation
-// ============================================================================
-
 int quran_renderer_draw_text(
     QuranRendererHandle renderer,
     QuranPixelBuffer* buffer,
@@ -984,15 +3649,6 @@ int quran_renderer_draw_text(
         if (fontSize < 12) fontSize = 12;  // Minimum readable size
     }
     
-    // Auto-detect text color if not specified (0 means auto)
-    uint32_t textColor;
-    if (config && config->textColor != 0) {
-        textColor = config->textColor;
-    } else {
-        // Auto: white text for dark backgrounds, black for light
-        textColor = isDarkBackground(bgColor) ? 0xFFFFFFFF : 0x000000FF;
-    }
-    
     // Set up Skia canvas with correct pixel format
     SkColorType colorType = (buffer->format == QURAN_PIXEL_FORMAT_BGRA8888)
         ? kBGRA_8888_SkColorType
@@ -1003,12 +3659,9 @@ int quran_renderer_draw_text(
     );
     auto canvas = SkCanvas::MakeRasterDirect(imageInfo, buffer->pixels, buffer->stride);
     
-    // Clear with background color
-    uint8_t bg_r = (bgColor >> 24) & 0xFF;
-    uint8_t bg_g = (bgColor >> 16) & 0xFF;
-    uint8_t bg_b = (bgColor >> 8) & 0xFF;
-    uint8_t bg_a = bgColor & 0xFF;
-    canvas->drawColor(SkColorSetARGB(bg_a, bg_r, bg_g, bg_b));
+    // Clear with background color, or only what the last draw inked
+    const bool recorded = renderer->beginFrame(canvas.get(), *buffer, bgColor,
+                                               config ? config->clearMode : QURAN_CLEAR_FULL);
     
     // Set up paint
     SkPaint paint;
@@ -1019,49 +3672,30 @@ int quran_renderer_draw_text(
     skia_context_t context{};
     context.canvas = canvas.get();
     context.paint = &paint;
-    context.backgroundColor = HB_COLOR(bg_r, bg_g, bg_b, bg_a);
     
-    // Extract text color
-    uint8_t txt_r = (textColor >> 24) & 0xFF;
-    uint8_t txt_g = (textColor >> 16) & 0xFF;
-    uint8_t txt_b = (textColor >> 8) & 0xFF;
-    hb_color_t hbTextColor = HB_COLOR(txt_r, txt_g, txt_b, 255);
-    context.foreground = hbTextColor;
+    // Text color: config's, else the theme's or automatic (0 means auto)
+    const ColorTable& colors = renderer->resolveColors(bgColor, config ? config->textColor : 0);
+    hb_color_t hbTextColor = colors.text;
+    setContextColors(&context, colors);
     
     // Tajweed handling: when tajweed is enabled, allow font colors through (use_foreground_override=false)
     // When disabled, force all glyphs to use foreground color (use_foreground_override=true)
     bool useTajweed = config ? config->tajweed : true;
     context.use_foreground_override = !useTajweed;  // false when tajweed enabled = allow font colors
     
-    // Create and shape the text
-    hb_buffer_t* hbBuffer = hb_buffer_create();
-    hb_buffer_set_direction(hbBuffer, HB_DIRECTION_RTL);
-    hb_buffer_set_script(hbBuffer, HB_SCRIPT_ARABIC);
-    hb_buffer_set_language(hbBuffer, renderer->ar_language);
-    
-    hb_buffer_add_utf8(hbBuffer, text, len, 0, len);
-    
     // Calculate line width in font units
     double scale = static_cast<double>(fontSize) / renderer->upem;
     double lineWidth = (targetWidth > 0) ? targetWidth / scale : (buffer->width - 20) / scale;
     
-    if (justify) {
-        hb_buffer_set_justify(hbBuffer, lineWidth);
-    }
-    
-    // Shape with tajweed based on config (useTajweed already set earlier)
-    renderer->features[0].value = useTajweed ? 1 : 0;
-    hb_shape(renderer->font, hbBuffer, renderer->features, 1);
-    
-    // Get glyph data
-    unsigned int count;
-    hb_glyph_info_t* glyph_info = hb_buffer_get_glyph_infos(hbBuffer, &count);
-    hb_glyph_position_t* glyph_pos = hb_buffer_get_glyph_positions(hbBuffer, &count);
+    // Shape with tajweed based on config (useTajweed already set earlier);
+    // repeated strings come from the renderer's shaped-string cache
+    std::shared_ptr<const ShapedText> shaped =
+        renderer->shapeTextCached(text, len, justify ? lineWidth : 0, useTajweed);
     
     // Calculate text width
     int totalWidth = 0;
-    for (unsigned int i = 0; i < count; i++) {
-        totalWidth += glyph_pos[i].x_advance;
+    for (unsigned int i = 0; i < shaped->count; i++) {
+        totalWidth += shaped->pos[i].x_advance;
     }
     
     // Calculate margins for positioning
@@ -1085,49 +3719,9 @@ int quran_renderer_draw_text(
     canvas->scale(scale, -scale);
     
     // Render glyphs
-    for (int i = count - 1; i >= 0; i--) {
-        auto glyph_index = glyph_info[i].codepoint;
-        
-        // Handle variable font coordinates for kashida
-        if (glyph_info[i].lefttatweel != 0 || glyph_info[i].righttatweel != 0) {
-            renderer->coords[0] = roundf(glyph_info[i].lefttatweel * 16384.f);
-            renderer->coords[1] = roundf(glyph_info[i].righttatweel * 16384.f);
-            renderer->font->num_coords = 2;
-            renderer->font->coords = &renderer->coords[0];
-        }
-        
-        canvas->translate(-glyph_pos[i].x_advance, 0);
-        
-        // Apply glyph offset BEFORE painting (mushaf-android approach)
-        canvas->translate(glyph_pos[i].x_offset, glyph_pos[i].y_offset);
-        
-        // Handle tajweed colors: lookup_index >= tajweedcolorindex indicates tajweed lookup was applied
-        hb_color_t glyphColor = hbTextColor;
-        if (useTajweed && glyph_pos[i].lookup_index >= renderer->tajweedcolorindex) {
-            glyphColor = HB_COLOR(
-                (glyph_pos[i].base_codepoint >> 8) & 0xff,
-                (glyph_pos[i].base_codepoint >> 16) & 0xff,
-                (glyph_pos[i].base_codepoint >> 24) & 0xff,
-                255
-            );
-        }
-        
-        // Update context foreground before painting so COLR use_foreground layers can access it
-        context.foreground = glyphColor;
-        hb_font_paint_glyph(renderer->font, glyph_index, renderer->paint_funcs, &context, 0, glyphColor);
-        
-        // Undo glyph offset AFTER painting (mushaf-android approach)
-        canvas->translate(-glyph_pos[i].x_offset, -glyph_pos[i].y_offset);
-        
-        // Reset variable font coords
-        if (glyph_info[i].lefttatweel != 0 || glyph_info[i].righttatweel != 0) {
-            renderer->font->num_coords = 0;
-            renderer->font->coords = nullptr;
-        }
-    }
-    
-    hb_buffer_destroy(hbBuffer);
+    renderer->paintGlyphs(&context, *shaped, LineFit{}, hbTextColor, useTajweed);
     
+    if (recorded) renderer->endFrame();
     return static_cast<int>(totalWidth * scale);
 }
 
@@ -1150,26 +3744,13 @@ bool quran_renderer_measure_text(
         return true;
     }
     
-    // Create and shape the text
-    hb_buffer_t* hbBuffer = hb_buffer_create();
-    hb_buffer_set_direction(hbBuffer, HB_DIRECTION_RTL);
-    hb_buffer_set_script(hbBuffer, HB_SCRIPT_ARABIC);
-    hb_buffer_set_language(hbBuffer, renderer->ar_language);
-    
-    hb_buffer_add_utf8(hbBuffer, text, len, 0, len);
-    
     // Tajweed doesn't affect measurement, but keep consistent
-    renderer->features[0].value = 1;
-    hb_shape(renderer->font, hbBuffer, renderer->features, 1);
-    
-    // Get glyph data
-    unsigned int count;
-    hb_glyph_position_t* glyph_pos = hb_buffer_get_glyph_positions(hbBuffer, &count);
+    std::shared_ptr<const ShapedText> shaped = renderer->shapeTextCached(text, len, 0, true);
     
     // Calculate width
     int totalWidth = 0;
-    for (unsigned int i = 0; i < count; i++) {
-        totalWidth += glyph_pos[i].x_advance;
+    for (unsigned int i = 0; i < shaped->count; i++) {
+        totalWidth += shaped->pos[i].x_advance;
     }
     
     double scale = static_cast<double>(fontSize) / renderer->upem;
@@ -1177,7 +3758,110 @@ bool quran_renderer_measure_text(
     if (outWidth) *outWidth = static_cast<int>(totalWidth * scale);
     if (outHeight) *outHeight = fontSize;
     
-    hb_buffer_destroy(hbBuffer);
+    return true;
+}
+
+int quran_renderer_fit_text_size(
+    QuranRendererHandle renderer,
+    const char* text,
+    int textLength,
+    float width,
+    int maxLines,
+    int minFontSize,
+    int maxFontSize
+) {
+    if (!renderer || !text || width <= 0 || minFontSize <= 0 || maxFontSize < minFontSize) {
+        return -1;
+    }
+    
+    size_t len = (textLength < 0) ? strlen(text) : static_cast<size_t>(textLength);
+    if (len == 0) {
+        return maxFontSize;
+    }
+    
+    const double upem = renderer->upem;
+    
+    // Single line: advances scale linearly with the font size, so solve directly
+    if (maxLines <= 1) {
+        int textWidth = renderer->advanceWidth(text, len, true);
+        if (textWidth <= 0) {
+            return maxFontSize;
+        }
+        int size = static_cast<int>(std::floor(width * upem / textWidth));
+        return std::max(minFontSize, std::min(maxFontSize, size));
+    }
+    
+    // Several lines: shape each word once, then binary search the size,
+    // wrapping the cached widths exactly as draw_wrapped_text does
+    const std::vector<int> wordWidths = measureWords(renderer, splitIntoWords(text, len));
+    const int spaceWidth = renderer->wordSpaceWidth(true);
+    const int widestWord = wordWidths.empty() ? 0 : *std::max_element(wordWidths.begin(), wordWidths.end());
+    
+    auto fits = [&](int fontSize) {
+        double lineWidth = width * upem / fontSize;   // Font units
+        // A word wider than the line never fits, whatever the line count
+        if (widestWord > lineWidth) {
+            return false;
+        }
+        return wrapWords(wordWidths, spaceWidth, lineWidth).size() <= static_cast<size_t>(maxLines);
+    };
+    
+    if (!fits(minFontSize)) {
+        return minFontSize;
+    }
+    
+    int low = minFontSize;
+    int high = maxFontSize;
+    while (low < high) {
+        int mid = low + (high - low + 1) / 2;
+        if (fits(mid)) {
+            low = mid;
+        } else {
+            high = mid - 1;
+        }
+    }
+    
+    return low;
+}
+
+bool quran_renderer_measure_text_bounds(
+    QuranRendererHandle renderer,
+    const char* text,
+    int textLength,
+    int fontSize,
+    QuranTextBounds* bounds
+) {
+    if (!renderer || !text || !bounds || fontSize <= 0) {
+        return false;
+    }
+    
+    *bounds = QuranTextBounds{};
+    
+    size_t len = (textLength < 0) ? strlen(text) : static_cast<size_t>(textLength);
+    if (len == 0) {
+        return true;
+    }
+    
+    // Shaped exactly like quran_renderer_measure_text
+    ShapedText shaped;
+    renderer->shapeText(text, len, 0, true, &shaped);
+    
+    double totalWidth = 0;
+    for (unsigned int i = 0; i < shaped.count; i++) {
+        totalWidth += shaped.pos[i].x_advance;
+    }
+    double scale = static_cast<double>(fontSize) / renderer->upem;
+    bounds->advance = static_cast<float>(totalWidth * scale);
+    
+    double left, bottom, right, top;
+    if (renderer->inkBounds(shaped, LineFit{}, &left, &bottom, &right, &top)) {
+        // Pen runs leftwards from the right edge; shift so the advance spans [0, advance]
+        // and flip y so the box is in pixel coordinates around the baseline
+        bounds->left = static_cast<float>((totalWidth + left) * scale);
+        bounds->right = static_cast<float>((totalWidth + right) * scale);
+        bounds->top = static_cast<float>(-top * scale);
+        bounds->bottom = static_cast<float>(-bottom * scale);
+    }
     
     return true;
 }
@@ -1220,11 +3904,9 @@ int quran_renderer_draw_multiline_text(
     );
     auto canvas = SkCanvas::MakeRasterDirect(imageInfo, buffer->pixels, buffer->stride);
     
-    uint8_t bg_r = (bgColor >> 24) & 0xFF;
-    uint8_t bg_g = (bgColor >> 16) & 0xFF;
-    uint8_t bg_b = (bgColor >> 8) & 0xFF;
-    uint8_t bg_a = bgColor & 0xFF;
-    canvas->drawColor(SkColorSetARGB(bg_a, bg_r, bg_g, bg_b));
+    const bool recorded = renderer->beginFrame(canvas.get(), *buffer, bgColor,
+                                               config ? config->clearMode : QURAN_CLEAR_FULL);
+    SkIRect ink = SkIRect::MakeEmpty();
     
     // Split text by newlines
     std::string fullText(text, len);
@@ -1239,6 +3921,7 @@ int quran_renderer_draw_multiline_text(
     QuranTextConfig lineConfig = config ? *config : QuranTextConfig{};
     lineConfig.fontSize = fontSize;  // Use resolved font size
     lineConfig.backgroundColor = 0x00000000; // Transparent (background already cleared)
+    lineConfig.clearMode = QURAN_CLEAR_NONE;
     // Keep textColor as-is (0 = auto will be resolved in draw_text based on original bgColor)
     if (config && config->textColor == 0) {
         // For auto text color, resolve it here based on the actual background
@@ -1276,50 +3959,15 @@ int quran_renderer_draw_multiline_text(
         if (lineBuffer.height <= 0) break;
         
         quran_renderer_draw_text(renderer, &lineBuffer, lines[i].c_str(), -1, &lineConfig);
+        ink.join(SkIRect::MakeXYWH(0, yOffset, lineBuffer.width, lineBuffer.height));
         
         yOffset += lineHeight;
     }
     
+    if (recorded) renderer->endFrame(ink);
     return static_cast<int>(lines.size());
 }
 
-// Helper: split UTF-8 string by spaces while preserving Arabic text integrity
-static std::vector<std::string> splitIntoWords(const char* text, size_t len) {
-    std::vector<std::string> words;
-    std::string current;
-    
-    for (size_t i = 0; i < len; ) {
-        unsigned char c = static_cast<unsigned char>(text[i]);
-        
-        // Check for space (ASCII space or Arabic space)
-        if (c == ' ' || c == '\t') {
-            if (!current.empty()) {
-                words.push_back(current);
-                current.clear();
-            }
-            i++;
-        } else {
-            // UTF-8 character: determine byte count
-            int charBytes = 1;
-            if ((c & 0xF8) == 0xF0) charBytes = 4;      // 4-byte UTF-8
-            else if ((c & 0xF0) == 0xE0) charBytes = 3; // 3-byte UTF-8
-            else if ((c & 0xE0) == 0xC0) charBytes = 2; // 2-byte UTF-8
-            
-            // Append full UTF-8 character
-            for (int j = 0; j < charBytes && i + j < len; j++) {
-                current += text[i + j];
-            }
-            i += charBytes;
-        }
-    }
-    
-    if (!current.empty()) {
-        words.push_back(current);
-    }
-    
-    return words;
-}
-
 int quran_renderer_draw_wrapped_text(
     QuranRendererHandle renderer,
     QuranPixelBuffer* buffer,
@@ -1381,74 +4029,33 @@ int quran_renderer_draw_wrapped_text(
     );
     auto canvas = SkCanvas::MakeRasterDirect(imageInfo, buffer->pixels, buffer->stride);
     
-    uint8_t bg_r = (bgColor >> 24) & 0xFF;
-    uint8_t bg_g = (bgColor >> 16) & 0xFF;
-    uint8_t bg_b = (bgColor >> 8) & 0xFF;
-    uint8_t bg_a = bgColor & 0xFF;
-    canvas->drawColor(SkColorSetARGB(bg_a, bg_r, bg_g, bg_b));
+    const bool recorded = renderer->beginFrame(canvas.get(), *buffer, bgColor,
+                                               config ? config->clearMode : QURAN_CLEAR_FULL);
+    SkIRect ink = SkIRect::MakeEmpty();
     
     // Split text into words (only at whitespace boundaries - never break mid-word)
     std::vector<std::string> words = splitIntoWords(text, len);
     
-    // Build lines by measuring and wrapping at word boundaries
+    // Wrap at word boundaries (never mid-word: Arabic letters would
+    // disconnect) in font units, the same way fit_text_size counts lines
+    const std::vector<int> wordWidths = measureWords(renderer, words);
+    const std::vector<size_t> lineStarts = wrapWords(wordWidths, renderer->wordSpaceWidth(true),
+                                                     maxLineWidth * renderer->upem / fontSize);
     std::vector<std::string> lines;
-    std::string currentLine;
-    int currentLineWidth = 0;
-    
-    // Calculate space width using HarfBuzz measurement
-    int spaceWidth = 0;
-    {
-        int withSpace = 0, withoutSpace = 0;
-        quran_renderer_measure_text(renderer, "ا ب", -1, fontSize, &withSpace, nullptr);
-        quran_renderer_measure_text(renderer, "اب", -1, fontSize, &withoutSpace, nullptr);
-        spaceWidth = withSpace - withoutSpace;
-        if (spaceWidth <= 0) {
-            // Fallback: estimate space as ~25% of fontSize
-            spaceWidth = fontSize / 4;
-        }
-    }
-    
-    for (const auto& word : words) {
-        int wordWidth = 0;
-        quran_renderer_measure_text(renderer, word.c_str(), word.length(), fontSize, &wordWidth, nullptr);
-        
-        if (currentLine.empty()) {
-            // First word on line
-            // Handle very long words that exceed maxLineWidth
-            if (wordWidth > maxLineWidth) {
-                // Word is too long - still add it (will be clipped, but don't break mid-word)
-                // For Arabic, breaking mid-word would disconnect letters incorrectly
-                currentLine = word;
-                currentLineWidth = wordWidth;
-            } else {
-                currentLine = word;
-                currentLineWidth = wordWidth;
-            }
-        } else {
-            // Check if word fits on current line (with space between)
-            int newWidth = currentLineWidth + spaceWidth + wordWidth;
-            if (newWidth <= maxLineWidth) {
-                // Fits - add with space
-                currentLine += " " + word;
-                currentLineWidth = newWidth;
-            } else {
-                // Doesn't fit - push current line and start new line with this word
-                lines.push_back(currentLine);
-                currentLine = word;
-                currentLineWidth = wordWidth;
-            }
+    for (size_t i = 0; i < lineStarts.size(); i++) {
+        const size_t end = i + 1 < lineStarts.size() ? lineStarts[i + 1] : words.size();
+        std::string line = words[lineStarts[i]];
+        for (size_t w = lineStarts[i] + 1; w < end; w++) {
+            line += " " + words[w];
         }
-    }
-    
-    // Don't forget last line
-    if (!currentLine.empty()) {
-        lines.push_back(currentLine);
+        lines.push_back(std::move(line));
     }
     
     // Create sub-config for rendering each line
     QuranTextConfig lineConfig = config ? *config : QuranTextConfig{};
     lineConfig.fontSize = fontSize;
     lineConfig.backgroundColor = 0x00000000; // Transparent (background already cleared)
+    lineConfig.clearMode = QURAN_CLEAR_NONE;
     lineConfig.lineWidth = maxLineWidth;     // Use calculated line width
     // Note: margins will be set per-line in the loop below
     
@@ -1488,11 +4095,238 @@ int quran_renderer_draw_wrapped_text(
         marginConfig.marginLeft = marginLeft;    // Use calculated left margin
         
         quran_renderer_draw_text(renderer, &lineBuffer, lines[i].c_str(), -1, &marginConfig);
+        ink.join(SkIRect::MakeXYWH(0, yOffset, lineBuffer.width, lineBuffer.height));
         
         yOffset += lineHeight;
     }
     
+    if (recorded) renderer->endFrame(ink);
     return static_cast<int>(lines.size());
 }
 
+// ============================================================================
+// Text Document Implementation
+// ============================================================================
+
+QuranTextDocumentHandle quran_text_document_create(
+    QuranRendererHandle renderer,
+    const char* text,
+    int textLength,
+    const QuranTextConfig* config,
+    float lineSpacing,
+    int width
+) {
+    if (!renderer || !text || width <= 0) {
+        return nullptr;
+    }
+    
+    size_t len = (textLength < 0) ? strlen(text) : static_cast<size_t>(textLength);
+    auto document = new QuranTextDocumentImpl(renderer, text, len, config, lineSpacing);
+    document->setWidth(width);
+    return document;
+}
+
+// Mushaf text of an ayah range: one paragraph per surah (its name and basmala
+// lines as paragraphs of their own), line breaks inside ayahs become spaces
+static bool appendAyahRangeText(int startSurah, int startAyah, int endSurah, int endAyah, std::string* out) {
+    if (startSurah < 1 || startSurah > QURAN_SURAH_COUNT || endSurah < 1 || endSurah > QURAN_SURAH_COUNT ||
+        startAyah < 1 || startAyah > SURAH_DATA[startSurah].ayahCount ||
+        endAyah < 1 || endAyah > SURAH_DATA[endSurah].ayahCount) {
+        return false;
+    }
+    if (SURAH_DATA[startSurah].startAyah + startAyah > SURAH_DATA[endSurah].startAyah + endAyah) {
+        return false;
+    }
+    
+    const QuranTextIndex& textIndex = QuranTextIndex::get();
+    std::vector<QuranLineRange> ranges;
+    
+    for (int surah = startSurah; surah <= endSurah; surah++) {
+        int first = (surah == startSurah) ? startAyah : 1;
+        int last = (surah == endSurah) ? endAyah : SURAH_DATA[surah].ayahCount;
+        
+        for (int ayah = first; ayah <= last; ayah++) {
+            ranges.clear();
+            int count = textIndex.ayahLineRanges(surah, ayah, &ranges);
+            if (count == 0) continue;
+            
+            if (ayah == 1) {
+                // Surah name and basmala lines directly above the first ayah
+                const QuranPageText& page = textIndex.pages[ranges[0].pageIndex];
+                int headerStart = ranges[0].lineIndex;
+                while (headerStart > 0 && page.lines[headerStart - 1].kind != QuranTextLineKind::Ayah) {
+                    headerStart--;
+                }
+                for (int line = headerStart; line < ranges[0].lineIndex; line++) {
+                    if (!out->empty()) out->push_back('\n');
+                    out->append(page.text + page.lines[line].start, page.lines[line].end - page.lines[line].start);
+                }
+                if (!out->empty()) out->push_back('\n');
+            } else if (!out->empty()) {
+                out->push_back(' ');
+            }
+            
+            for (int i = 0; i < count; i++) {
+                if (i > 0) out->push_back(' ');
+                out->append(textIndex.pages[ranges[i].pageIndex].text + ranges[i].start,
+                            ranges[i].end - ranges[i].start);
+            }
+        }
+    }
+    return true;
+}
+
+QuranTextDocumentHandle quran_text_document_create_ayahs(
+    QuranRendererHandle renderer,
+    int startSurah,
+    int startAyah,
+    int endSurah,
+    int endAyah,
+    const QuranTextConfig* config,
+    float lineSpacing,
+    int width
+) {
+    if (!renderer || width <= 0) {
+        return nullptr;
+    }
+    
+    std::string text;
+    if (!appendAyahRangeText(startSurah, startAyah, endSurah, endAyah, &text)) {
+        return nullptr;
+    }
+    
+    auto document = new QuranTextDocumentImpl(renderer, text.data(), text.size(), config, lineSpacing);
+    document->setWidth(width);
+    return document;
+}
+
+void quran_text_document_destroy(QuranTextDocumentHandle document) {
+    delete document;
+}
+
+void quran_text_document_set_width(QuranTextDocumentHandle document, int width) {
+    if (!document || width <= 0) return;
+    document->setWidth(width);
+}
+
+void quran_text_document_set_font_size(QuranTextDocumentHandle document, int fontSize) {
+    if (!document || fontSize <= 0) return;
+    document->setFontSize(fontSize);
+}
+
+int quran_text_document_get_height(QuranTextDocumentHandle document) {
+    return document ? document->height() : 0;
+}
+
+int quran_text_document_get_line_count(QuranTextDocumentHandle document) {
+    return document ? document->lineCount() : 0;
+}
+
+int quran_text_document_draw(
+    QuranTextDocumentHandle document,
+    QuranPixelBuffer* buffer,
+    int scrollY
+) {
+    if (!document || !buffer || !buffer->pixels) {
+        return -1;
+    }
+    
+    return document->draw(buffer, scrollY);
+}
+
+// ============================================================================
+// Text Input API Implementation
+// ============================================================================
+
+QuranTextInputHandle quran_text_input_create(
+    QuranRendererHandle renderer,
+    const QuranTextConfig* config
+) {
+    if (!renderer) {
+        return nullptr;
+    }
+    
+    return new QuranTextInputImpl(renderer, config);
+}
+
+void quran_text_input_destroy(QuranTextInputHandle input) {
+    delete input;
+}
+
+void quran_text_input_invalidate(QuranTextInputHandle input) {
+    if (input) input->painted = false;
+}
+
+int quran_text_input_update(
+    QuranTextInputHandle input,
+    QuranPixelBuffer* buffer,
+    const char* text,
+    int textLength,
+    QuranRect* dirty
+) {
+    if (!input || !buffer || !buffer->pixels || !text) {
+        return -1;
+    }
+    
+    size_t len = (textLength < 0) ? strlen(text) : static_cast<size_t>(textLength);
+    return input->update(buffer, text, len, dirty);
+}
+
+// ============================================================================
+// Scroll Strip API Implementation
+// ============================================================================
+
+QuranScrollStripHandle quran_scroll_strip_create(
+    QuranRendererHandle renderer,
+    const QuranRenderConfig* config,
+    int width,
+    int pageGap
+) {
+    if (!renderer || width <= 0) {
+        return nullptr;
+    }
+    
+    auto strip = new QuranScrollStripImpl(renderer, config, pageGap);
+    strip->setWidth(width);
+    return strip;
+}
+
+void quran_scroll_strip_destroy(QuranScrollStripHandle strip) {
+    delete strip;
+}
+
+void quran_scroll_strip_set_width(QuranScrollStripHandle strip, int width) {
+    if (!strip || width <= 0) return;
+    strip->setWidth(width);
+}
+
+int quran_scroll_strip_get_height(QuranScrollStripHandle strip) {
+    return strip ? strip->height() : 0;
+}
+
+int quran_scroll_strip_get_line_height(QuranScrollStripHandle strip) {
+    return strip ? strip->layout.inter_line : 0;
+}
+
+int quran_scroll_strip_get_page_top(QuranScrollStripHandle strip, int pageIndex) {
+    if (!strip || pageIndex < 0 || pageIndex >= 604) return -1;
+    return strip->lineTops[strip->pageFirstLine[pageIndex]];
+}
+
+int quran_scroll_strip_get_page_at(QuranScrollStripHandle strip, int y) {
+    return strip ? strip->pageAt(y) : -1;
+}
+
+int quran_scroll_strip_draw(
+    QuranScrollStripHandle strip,
+    QuranPixelBuffer* buffer,
+    int y0
+) {
+    if (!strip || !buffer || !buffer->pixels) {
+        return -1;
+    }
+    
+    return strip->draw(buffer, y0);
+}
+
 } // extern "C"
@@ -0,0 +1,236 @@
+/**
+ * Quran search - diacritic-insensitive full-text index over qurantext
+ */
+
+#include "quran_search.h"
+
+#include <assert.h>
+#include <string.h>
+#include <algorithm>
+
+#include "quran_metadata.h"
+#include "quran_text_index.h"
+
+namespace {
+
+constexpr uint8_t kSpace = 0x20;
+constexpr uint8_t kUnknownLetter = 0x7F;
+constexpr uint8_t kNoLetter = 0;
+
+// Code points removed entirely: harakat, superscript alef, Quranic annotation
+// signs, small high letters, tatweel and zero-width format characters
+inline bool isIgnored(uint32_t cp) {
+    return (cp >= 0x0610 && cp <= 0x061A) ||
+           (cp >= 0x064B && cp <= 0x065F) ||
+           cp == 0x0640 ||
+           cp == 0x0670 ||
+           (cp >= 0x06D6 && cp <= 0x06DC) ||
+           (cp >= 0x06DF && cp <= 0x06E8) ||
+           (cp >= 0x06EA && cp <= 0x06ED) ||
+           (cp >= 0x08D3 && cp <= 0x08FF) ||
+           (cp >= 0x200B && cp <= 0x200F) ||
+           cp == 0x034F;
+}
+
+// Code points that separate words: whitespace, ayah markers, rub el hizb, sajda
+inline bool isSeparator(uint32_t cp) {
+    return quranIsWhitespace(cp) || quranIsAyahMarker(cp) ||
+           cp == 0x06DE || cp == 0x06E9 ||
+           (cp >= '0' && cp <= '9');
+}
+
+// Maps a code point to its search byte, kSpace, or kNoLetter when dropped
+inline uint8_t searchByte(uint32_t cp) {
+    if (isIgnored(cp)) {
+        return kNoLetter;
+    }
+    if (isSeparator(cp)) {
+        return kSpace;
+    }
+    switch (cp) {
+        case 0x0622:  // alef with madda
+        case 0x0623:  // alef with hamza above
+        case 0x0625:  // alef with hamza below
+        case 0x0671:  // alef wasla
+        case 0x0672:
+        case 0x0673:
+            cp = 0x0627;
+            break;
+        default:
+            break;
+    }
+    if (cp >= 0x0621 && cp <= 0x064A) {
+        return static_cast<uint8_t>(0x40 + (cp - 0x0620));
+    }
+    return kUnknownLetter;
+}
+
+// Appends one normalized byte, collapsing runs of spaces
+template <typename OnAppend>
+inline void appendNormalized(std::vector<uint8_t>& out, uint8_t value, OnAppend onAppend) {
+    if (value == kNoLetter) return;
+    if (value == kSpace && (out.empty() || out.back() == kSpace)) return;
+    out.push_back(value);
+    onAppend();
+}
+
+} // anonymous namespace
+
+std::string quranNormalizeSearchText(const char* text, size_t length) {
+    std::vector<uint8_t> out;
+    out.reserve(length / 2);
+
+    uint32_t offset = 0;
+    uint32_t size = static_cast<uint32_t>(length);
+    while (offset < size) {
+        uint32_t cp = quranDecodeUtf8(text, size, &offset);
+        appendNormalized(out, searchByte(cp), [] {});
+    }
+    while (!out.empty() && out.back() == kSpace) {
+        out.pop_back();
+    }
+
+    return std::string(out.begin(), out.end());
+}
+
+const QuranSearchIndex& QuranSearchIndex::get() {
+    static const QuranSearchIndex index;
+    return index;
+}
+
+QuranSearchIndex::QuranSearchIndex() {
+    build();
+}
+
+void QuranSearchIndex::build() {
+    const QuranTextIndex& textIndex = QuranTextIndex::get();
+
+    // ~330k letters and ~77k word gaps in the full text
+    corpus.reserve(450000);
+    sourcePositions.reserve(450000);
+
+    for (int pageIndex = 0; pageIndex < QURAN_PAGE_COUNT; pageIndex++) {
+        const QuranPageText& page = textIndex.pages[pageIndex];
+
+        for (const QuranTextLine& line : page.lines) {
+            // Surah names and standalone basmalas are not ayah text
+            if (line.kind != QuranTextLineKind::Ayah) {
+                continue;
+            }
+
+            uint32_t offset = line.start;
+            while (offset < line.end) {
+                uint32_t cpStart = offset;
+                uint32_t cp = quranDecodeUtf8(page.text, line.end, &offset);
+                appendNormalized(corpus, searchByte(cp), [&] {
+                    sourcePositions.push_back((static_cast<uint32_t>(pageIndex) << 16) | cpStart);
+                });
+            }
+
+            // Line breaks separate words; the position points at the line end
+            appendNormalized(corpus, kSpace, [&] {
+                sourcePositions.push_back((static_cast<uint32_t>(pageIndex) << 16) | line.end);
+            });
+        }
+    }
+
+    suffixArray.reserve(corpus.size());
+    for (uint32_t i = 0; i < corpus.size(); i++) {
+        if (corpus[i] != kSpace) {
+            suffixArray.push_back(i);
+        }
+    }
+
+    const uint8_t* data = corpus.data();
+    const size_t size = corpus.size();
+    std::sort(suffixArray.begin(), suffixArray.end(), [data, size](uint32_t a, uint32_t b) {
+        size_t lengthA = size - a;
+        size_t lengthB = size - b;
+        int cmp = memcmp(data + a, data + b, std::min(lengthA, lengthB));
+        return cmp != 0 ? cmp < 0 : lengthA < lengthB;
+    });
+}
+
+int QuranSearchIndex::search(const char* query, size_t queryLength, int maxResults,
+                             std::vector<QuranSearchMatch>* results) const {
+    std::string needle = quranNormalizeSearchText(query, queryLength);
+    size_t start = needle.find_first_not_of(static_cast<char>(kSpace));
+    if (start == std::string::npos) {
+        return 0;
+    }
+    needle.erase(0, start);
+
+    const uint8_t* data = corpus.data();
+    const size_t size = corpus.size();
+    const uint8_t* key = reinterpret_cast<const uint8_t*>(needle.data());
+    const size_t keyLength = needle.size();
+
+    // Compare the first keyLength bytes of a suffix against the key
+    auto comparePrefix = [&](uint32_t suffix) {
+        size_t available = size - suffix;
+        int cmp = memcmp(data + suffix, key, std::min(available, keyLength));
+        if (cmp != 0) return cmp;
+        return available < keyLength ? -1 : 0;
+    };
+
+    auto first = std::lower_bound(suffixArray.begin(), suffixArray.end(), 0,
+        [&](uint32_t suffix, int) { return comparePrefix(suffix) < 0; });
+    auto last = std::upper_bound(first, suffixArray.end(), 0,
+        [&](int, uint32_t suffix) { return comparePrefix(suffix) > 0; });
+
+    int total = static_cast<int>(last - first);
+    if (!results || maxResults <= 0 || total == 0) {
+        return total;
+    }
+
+    // Report matches in mushaf order
+    std::vector<uint32_t> matches(first, last);
+    if (static_cast<int>(matches.size()) > maxResults) {
+        std::nth_element(matches.begin(), matches.begin() + maxResults, matches.end());
+        matches.resize(maxResults);
+    }
+    std::sort(matches.begin(), matches.end());
+
+    const QuranTextIndex& textIndex = QuranTextIndex::get();
+
+    for (uint32_t corpusStart : matches) {
+        uint32_t startPosition = sourcePositions[corpusStart];
+        uint32_t endPosition = sourcePositions[corpusStart + keyLength - 1];
+
+        int pageIndex = static_cast<int>(startPosition >> 16);
+        uint32_t byteStart = startPosition & 0xFFFF;
+        // A match starts on a letter, and every letter is inside a line: each
+        // counted match fills an entry
+        int lineIndex = textIndex.lineAt(pageIndex, byteStart);
+        assert(lineIndex >= 0);
+
+        const QuranPageText& page = textIndex.pages[pageIndex];
+        const QuranTextLine& line = page.lines[lineIndex];
+
+        // Extend the last matched letter over the marks that follow it
+        uint32_t byteEnd = line.end;
+        if (static_cast<int>(endPosition >> 16) == pageIndex && (endPosition & 0xFFFF) < line.end) {
+            uint32_t offset = endPosition & 0xFFFF;
+            quranDecodeUtf8(page.text, line.end, &offset);
+            while (offset < line.end) {
+                uint32_t next = offset;
+                uint32_t cp = quranDecodeUtf8(page.text, line.end, &next);
+                if (searchByte(cp) != kNoLetter) break;
+                offset = next;
+            }
+            byteEnd = offset;
+        }
+
+        QuranSearchMatch match;
+        match.pageIndex = pageIndex;
+        match.lineIndex = lineIndex;
+        match.byteStart = static_cast<int>(byteStart - line.start);
+        match.byteEnd = static_cast<int>(byteEnd - line.start);
+        match.surahNumber = 0;
+        match.ayahNumber = 0;
+        textIndex.ayahAt(pageIndex, byteStart, &match.surahNumber, &match.ayahNumber);
+        results->push_back(match);
+    }
+
+    return total;
+}
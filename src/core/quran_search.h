@@ -0,0 +1,49 @@
+/**
+ * Quran search - diacritic-insensitive full-text index over qurantext
+ *
+ * Text is normalized by dropping harakat, Quranic annotation marks and
+ * tatweel and by folding every alef form to a bare alef. The normalized
+ * corpus is indexed with a suffix array, so a query costs O(m log n)
+ * comparisons plus one lookup per hit.
+ */
+
+#ifndef QURAN_RENDERER_QURAN_SEARCH_H
+#define QURAN_RENDERER_QURAN_SEARCH_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct QuranSearchMatch {
+    int pageIndex;
+    int lineIndex;
+    int byteStart;      // Offset in the line's UTF-8 text
+    int byteEnd;        // Exclusive, clamped to the line end when the match wraps
+    int surahNumber;
+    int ayahNumber;
+};
+
+struct QuranSearchIndex {
+    // Normalized corpus: one byte per letter, 0x20 between words
+    std::vector<uint8_t> corpus;
+    // Source position of every corpus byte: (pageIndex << 16) | byte offset in page text
+    std::vector<uint32_t> sourcePositions;
+    // Corpus offsets of all non-space bytes, sorted by suffix
+    std::vector<uint32_t> suffixArray;
+
+    // Built on first use (or eagerly via quran_renderer_prepare_search_index)
+    static const QuranSearchIndex& get();
+
+    // Appends matches in mushaf order; returns the total number of matches
+    int search(const char* query, size_t queryLength, int maxResults,
+               std::vector<QuranSearchMatch>* results) const;
+
+private:
+    QuranSearchIndex();
+    void build();
+};
+
+// Normalizes UTF-8 text to the search alphabet (exposed for tests/tools)
+std::string quranNormalizeSearchText(const char* text, size_t length);
+
+#endif // QURAN_RENDERER_QURAN_SEARCH_H
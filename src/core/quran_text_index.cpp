@@ -0,0 +1,243 @@
+/**
+ * Quran text index - line and ayah boundaries inside the qurantext pages
+ */
+
+#include "quran_text_index.h"
+
+#include <string.h>
+#include <algorithm>
+
+#include "quran.h"
+#include "quran_metadata.h"
+
+namespace {
+
+// Must match the literals used by QuranRendererImpl::parseQuranText
+const char* kBismText = "بِسْمِ ٱللَّهِ ٱلرَّحْمَٰنِ ٱلرَّحِيمِ";
+const char* kSurahPrefix = "سُورَة";
+
+QuranTextLineKind classifyLine(const char* text, uint32_t start, uint32_t end) {
+    size_t length = end - start;
+    size_t prefixLength = strlen(kSurahPrefix);
+    if (length >= prefixLength && memcmp(text + start, kSurahPrefix, prefixLength) == 0) {
+        return QuranTextLineKind::SurahName;
+    }
+    if (length == strlen(kBismText) && memcmp(text + start, kBismText, length) == 0) {
+        return QuranTextLineKind::Bism;
+    }
+    return QuranTextLineKind::Ayah;
+}
+
+inline int digitValue(uint32_t cp) {
+    if (cp >= 0x0660 && cp <= 0x0669) return static_cast<int>(cp - 0x0660);
+    if (cp >= 0x06F0 && cp <= 0x06F9) return static_cast<int>(cp - 0x06F0);
+    return -1;
+}
+
+} // anonymous namespace
+
+bool quranIsAyahMarker(uint32_t cp) {
+    return cp == 0x06DD || digitValue(cp) >= 0;
+}
+
+const QuranTextIndex& QuranTextIndex::get() {
+    static const QuranTextIndex index;
+    return index;
+}
+
+QuranTextIndex::QuranTextIndex() {
+    build();
+}
+
+void QuranTextIndex::build() {
+    // Ayah starts whose number is only known once the end-of-ayah marker is
+    // reached, possibly on a following page: (page, index into page.ayahs)
+    std::vector<std::pair<int, size_t>> pending;
+    // Segments of the open ayah are the tail of `segments` from this index
+    size_t pendingSegments = 0;
+    int surahNumber = 0;
+    int lastAyahNumber = 0;
+    bool ayahOpen = false;
+
+    pages.resize(QURAN_PAGE_COUNT);
+    segments.reserve(QURAN_TOTAL_AYAHS + QURAN_PAGE_COUNT);
+    ayahFirstSegment.assign(QURAN_TOTAL_AYAHS, 0);
+    ayahSegmentCount.assign(QURAN_TOTAL_AYAHS, 0);
+
+    for (int pageIndex = 0; pageIndex < QURAN_PAGE_COUNT; pageIndex++) {
+        QuranPageText& page = pages[pageIndex];
+        page.text = qurantext[pageIndex] + 1;
+        page.size = static_cast<uint32_t>(strlen(page.text));
+
+        // Split lines with std::getline semantics (no empty line after a trailing '\n')
+        uint32_t lineStart = 0;
+        while (lineStart < page.size) {
+            const char* newline = static_cast<const char*>(
+                memchr(page.text + lineStart, '\n', page.size - lineStart));
+            uint32_t lineEnd = newline ? static_cast<uint32_t>(newline - page.text) : page.size;
+            page.lines.push_back({lineStart, lineEnd, classifyLine(page.text, lineStart, lineEnd)});
+            lineStart = lineEnd + 1;
+        }
+
+        for (const QuranTextLine& line : page.lines) {
+            if (line.kind == QuranTextLineKind::SurahName) {
+                surahNumber++;
+                lastAyahNumber = 0;
+                ayahOpen = false;
+                pending.clear();
+                segments.resize(pendingSegments);
+                continue;
+            }
+            if (line.kind == QuranTextLineKind::Bism) {
+                continue;
+            }
+
+            uint32_t offset = line.start;
+            while (offset < line.end) {
+                uint32_t cpStart = offset;
+                uint32_t cp = quranDecodeUtf8(page.text, line.end, &offset);
+
+                if (quranIsWhitespace(cp)) {
+                    continue;
+                }
+
+                if (quranIsAyahMarker(cp)) {
+                    if (!ayahOpen) {
+                        continue;
+                    }
+
+                    // Consume the whole marker run (U+06DD followed by digits)
+                    int number = 0;
+                    bool hasDigits = false;
+                    uint32_t markerOffset = cpStart;
+                    while (markerOffset < line.end) {
+                        uint32_t next = markerOffset;
+                        uint32_t markerCp = quranDecodeUtf8(page.text, line.end, &next);
+                        if (!quranIsAyahMarker(markerCp)) break;
+                        int digit = digitValue(markerCp);
+                        if (digit >= 0) {
+                            number = number * 10 + digit;
+                            hasDigits = true;
+                        }
+                        markerOffset = next;
+                    }
+                    offset = markerOffset;
+                    segments.back().end = markerOffset;
+
+                    lastAyahNumber = hasDigits ? number : lastAyahNumber + 1;
+                    for (const auto& entry : pending) {
+                        pages[entry.first].ayahs[entry.second].ayahNumber =
+                            static_cast<uint16_t>(lastAyahNumber);
+                    }
+
+                    if (surahNumber >= 1 && surahNumber <= QURAN_SURAH_COUNT &&
+                        lastAyahNumber >= 1 && lastAyahNumber <= SURAH_DATA[surahNumber].ayahCount) {
+                        int globalAyah = SURAH_DATA[surahNumber].startAyah + lastAyahNumber - 1;
+                        ayahFirstSegment[globalAyah] = static_cast<uint32_t>(pendingSegments);
+                        ayahSegmentCount[globalAyah] = static_cast<uint8_t>(segments.size() - pendingSegments);
+                    }
+
+                    pending.clear();
+                    pendingSegments = segments.size();
+                    ayahOpen = false;
+                    continue;
+                }
+
+                if (!ayahOpen) {
+                    page.ayahs.push_back({cpStart, static_cast<uint16_t>(surahNumber), 0});
+                    pending.emplace_back(pageIndex, page.ayahs.size() - 1);
+                    segments.push_back({static_cast<uint16_t>(pageIndex), cpStart, offset});
+                    ayahOpen = true;
+                }
+                segments.back().end = offset;
+            }
+        }
+
+        // An ayah still open here continues on the next page: its first
+        // character there gets its own start entry, numbered by the same marker
+        ayahOpen = false;
+    }
+}
+
+int QuranTextIndex::lineAt(int pageIndex, uint32_t offset) const {
+    if (pageIndex < 0 || pageIndex >= static_cast<int>(pages.size())) {
+        return -1;
+    }
+
+    const auto& lines = pages[pageIndex].lines;
+    auto it = std::upper_bound(lines.begin(), lines.end(), offset,
+        [](uint32_t value, const QuranTextLine& line) { return value < line.start; });
+    if (it == lines.begin()) {
+        return -1;
+    }
+    --it;
+    return (offset < it->end) ? static_cast<int>(it - lines.begin()) : -1;
+}
+
+bool QuranTextIndex::ayahAt(int pageIndex, uint32_t offset, int* surahNumber, int* ayahNumber) const {
+    int lineIndex = lineAt(pageIndex, offset);
+    if (lineIndex < 0) {
+        return false;
+    }
+
+    const QuranPageText& page = pages[pageIndex];
+    if (page.lines[lineIndex].kind != QuranTextLineKind::Ayah) {
+        return false;
+    }
+
+    auto it = std::upper_bound(page.ayahs.begin(), page.ayahs.end(), offset,
+        [](uint32_t value, const QuranAyahStart& start) { return value < start.offset; });
+    if (it == page.ayahs.begin()) {
+        return false;
+    }
+    --it;
+
+    if (surahNumber) *surahNumber = it->surahNumber;
+    if (ayahNumber) *ayahNumber = it->ayahNumber;
+    return true;
+}
+
+int QuranTextIndex::ayahSegments(int surahNumber, int ayahNumber, const QuranAyahSegment** first) const {
+    if (surahNumber < 1 || surahNumber > QURAN_SURAH_COUNT) {
+        return 0;
+    }
+    if (ayahNumber < 1 || ayahNumber > SURAH_DATA[surahNumber].ayahCount) {
+        return 0;
+    }
+
+    int globalAyah = SURAH_DATA[surahNumber].startAyah + ayahNumber - 1;
+    int count = ayahSegmentCount[globalAyah];
+    if (count > 0 && first) {
+        *first = &segments[ayahFirstSegment[globalAyah]];
+    }
+    return count;
+}
+
+int QuranTextIndex::ayahLineRanges(int surahNumber, int ayahNumber, std::vector<QuranLineRange>* out) const {
+    const QuranAyahSegment* first = nullptr;
+    int segmentCount = ayahSegments(surahNumber, ayahNumber, &first);
+
+    int count = 0;
+    for (int i = 0; i < segmentCount; i++) {
+        const QuranAyahSegment& segment = first[i];
+        const QuranPageText& page = pages[segment.pageIndex];
+
+        for (size_t lineIndex = 0; lineIndex < page.lines.size(); lineIndex++) {
+            const QuranTextLine& line = page.lines[lineIndex];
+            uint32_t start = std::max(segment.start, line.start);
+            uint32_t end = std::min(segment.end, line.end);
+
+            // Trim the spaces left at line edges
+            while (start < end && page.text[start] == ' ') start++;
+            while (end > start && page.text[end - 1] == ' ') end--;
+            if (start >= end) {
+                continue;
+            }
+
+            out->push_back({segment.pageIndex, static_cast<int>(lineIndex), start, end});
+            count++;
+        }
+    }
+
+    return count;
+}
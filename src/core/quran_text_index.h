@@ -0,0 +1,134 @@
+/**
+ * Quran text index - line and ayah boundaries inside the qurantext pages
+ *
+ * Walks the 604 page strings once and records where every line and every
+ * ayah starts, so callers can map a byte offset back to (line, surah, ayah)
+ * and an ayah to the exact byte ranges it occupies, without re-parsing.
+ */
+
+#ifndef QURAN_RENDERER_QURAN_TEXT_INDEX_H
+#define QURAN_RENDERER_QURAN_TEXT_INDEX_H
+
+#include <cstdint>
+#include <vector>
+
+enum class QuranTextLineKind : uint8_t {
+    Ayah = 0,       // Regular ayah text
+    SurahName = 1,  // "سُورَة ..." header line
+    Bism = 2,       // Basmala line preceding a surah (not part of any ayah)
+};
+
+// Byte range of one line inside a page's text.
+// Lines are split exactly like QuranRendererImpl::parseQuranText.
+struct QuranTextLine {
+    uint32_t start;
+    uint32_t end;
+    QuranTextLineKind kind;
+};
+
+// First byte of an ayah's text on a page. An ayah that continues from the
+// previous page gets an entry at the first character of this page.
+struct QuranAyahStart {
+    uint32_t offset;
+    uint16_t surahNumber;
+    uint16_t ayahNumber;
+};
+
+// Byte range of an ayah on one page: from its first character up to and
+// including its end-of-ayah marker. May cover several lines; an ayah that
+// crosses a page boundary has one segment per page.
+struct QuranAyahSegment {
+    uint16_t pageIndex;
+    uint32_t start;
+    uint32_t end;
+};
+
+// Part of an ayah on a single line (offsets into the page text)
+struct QuranLineRange {
+    int pageIndex;
+    int lineIndex;
+    uint32_t start;
+    uint32_t end;
+};
+
+struct QuranPageText {
+    const char* text = nullptr;   // qurantext[page] + 1 (same base the renderer uses)
+    uint32_t size = 0;
+    std::vector<QuranTextLine> lines;
+    std::vector<QuranAyahStart> ayahs;  // Sorted by offset
+};
+
+struct QuranTextIndex {
+    std::vector<QuranPageText> pages;
+    std::vector<QuranAyahSegment> segments;     // In mushaf order
+    std::vector<uint32_t> ayahFirstSegment;     // Per global ayah (SurahData::startAyah + ayah - 1)
+    std::vector<uint8_t> ayahSegmentCount;
+
+    // Built on first use; the qurantext data is static so the index is shared
+    static const QuranTextIndex& get();
+
+    // Line containing offset, or -1 when offset is outside every line
+    int lineAt(int pageIndex, uint32_t offset) const;
+
+    // Surah/ayah whose text covers offset; false for surah names and basmalas
+    bool ayahAt(int pageIndex, uint32_t offset, int* surahNumber, int* ayahNumber) const;
+
+    // Segments of an ayah; returns the count (0 for invalid surah/ayah)
+    int ayahSegments(int surahNumber, int ayahNumber, const QuranAyahSegment** first) const;
+
+    // Splits an ayah's segments at line breaks; appends to out and returns the count
+    int ayahLineRanges(int surahNumber, int ayahNumber, std::vector<QuranLineRange>* out) const;
+
+private:
+    QuranTextIndex();
+    void build();
+};
+
+// UTF-8 helpers shared by the text subsystems. Inline so that code using
+// only these (the tajweed classifier and its test) doesn't pull in the text.
+inline uint32_t quranDecodeUtf8(const char* text, uint32_t size, uint32_t* offset) {
+    const unsigned char* s = reinterpret_cast<const unsigned char*>(text);
+    uint32_t i = *offset;
+    unsigned char c = s[i];
+    uint32_t cp;
+    int extra;
+
+    if (c < 0x80) {
+        cp = c;
+        extra = 0;
+    } else if ((c & 0xE0) == 0xC0) {
+        cp = c & 0x1F;
+        extra = 1;
+    } else if ((c & 0xF0) == 0xE0) {
+        cp = c & 0x0F;
+        extra = 2;
+    } else if ((c & 0xF8) == 0xF0) {
+        cp = c & 0x07;
+        extra = 3;
+    } else {
+        *offset = i + 1;
+        return 0xFFFD;
+    }
+
+    i++;
+    for (int k = 0; k < extra; k++) {
+        if (i >= size || (s[i] & 0xC0) != 0x80) {
+            *offset = i;
+            return 0xFFFD;
+        }
+        cp = (cp << 6) | (s[i] & 0x3F);
+        i++;
+    }
+
+    *offset = i;
+    return cp;
+}
+
+// Code point predicates
+bool quranIsAyahMarker(uint32_t cp);     // U+06DD end-of-ayah sign and digits
+
+inline bool quranIsWhitespace(uint32_t cp) {
+    return cp == ' ' || cp == '\t' || cp == '\n' || cp == '\r' || cp == 0x00A0;
+}
+
+#endif // QURAN_RENDERER_QURAN_TEXT_INDEX_H
@@ -0,0 +1,228 @@
+/**
+ * Tajweed classifier - rule-based tajweed color classes for the page text
+ */
+
+#include "tajweed_classifier.h"
+
+#include <array>
+#include <cstddef>
+
+#include "quran_text_index.h"
+
+namespace {
+
+// Code point properties used by the rules
+enum : uint32_t {
+    kLetter       = 1u << 0,
+    kMark         = 1u << 1,
+    kVowel        = 1u << 2,    // Fatha, damma, kasra and tanween
+    kOpensMouth   = 1u << 3,    // Fatha/damma (and their tanween): heavy ra
+    kTanween      = 1u << 4,
+    kOpenTanween  = 1u << 5,    // Sequential tanween: idgham/ikhfa follows
+    kSukun        = 1u << 6,
+    kShadda       = 1u << 7,
+    kMaddah       = 1u << 8,
+    kSilent       = 1u << 9,    // Small high zeros: letter is not pronounced
+    kIqlab        = 1u << 10,   // Small meem replacing a noon sound
+    kQalqala      = 1u << 11,
+    kHeavy        = 1u << 12,
+    kHamza        = 1u << 13,
+    kNoon         = 1u << 14,
+    kMeem         = 1u << 15,
+    kRa           = 1u << 16,
+    kLam          = 1u << 17,
+    kAlefWasla    = 1u << 18,
+    kWordPart     = 1u << 19,   // Not a letter but doesn't end the word (tatweel)
+};
+
+constexpr uint32_t kArabicBase = 0x0600;
+
+constexpr std::array<uint32_t, 256> makeArabicFlags() {
+    std::array<uint32_t, 256> flags{};
+
+    for (uint32_t cp = 0x0621; cp <= 0x063A; cp++) flags[cp - kArabicBase] |= kLetter;
+    for (uint32_t cp = 0x0641; cp <= 0x064A; cp++) flags[cp - kArabicBase] |= kLetter;
+    for (uint32_t cp = 0x0671; cp <= 0x06D3; cp++) flags[cp - kArabicBase] |= kLetter;
+    flags[0x06E5 - kArabicBase] |= kLetter;     // Small waw (silah)
+    flags[0x06E6 - kArabicBase] |= kLetter;     // Small yeh (silah)
+    flags[0x0640 - kArabicBase] |= kWordPart;   // Tatweel
+
+    for (uint32_t cp = 0x064B; cp <= 0x065F; cp++) flags[cp - kArabicBase] |= kMark;
+    flags[0x0670 - kArabicBase] |= kMark;       // Superscript alef
+    for (uint32_t cp = 0x06D6; cp <= 0x06DC; cp++) flags[cp - kArabicBase] |= kMark;
+    for (uint32_t cp = 0x06DF; cp <= 0x06E4; cp++) flags[cp - kArabicBase] |= kMark;
+    flags[0x06E7 - kArabicBase] |= kMark;
+    flags[0x06E8 - kArabicBase] |= kMark;
+    for (uint32_t cp = 0x06EA; cp <= 0x06ED; cp++) flags[cp - kArabicBase] |= kMark;
+
+    flags[0x064B - kArabicBase] |= kVowel | kTanween | kOpensMouth;
+    flags[0x064C - kArabicBase] |= kVowel | kTanween | kOpensMouth;
+    flags[0x064D - kArabicBase] |= kVowel | kTanween;
+    flags[0x064E - kArabicBase] |= kVowel | kOpensMouth;
+    flags[0x064F - kArabicBase] |= kVowel | kOpensMouth;
+    flags[0x0650 - kArabicBase] |= kVowel;
+    flags[0x0651 - kArabicBase] |= kShadda;
+    flags[0x0652 - kArabicBase] |= kSukun;
+    flags[0x06E1 - kArabicBase] |= kSukun;      // Quranic sukun (dotless head of khah)
+    flags[0x0653 - kArabicBase] |= kMaddah;
+    flags[0x06DF - kArabicBase] |= kSilent;
+    flags[0x06E0 - kArabicBase] |= kSilent;
+    flags[0x06E2 - kArabicBase] |= kIqlab;
+    flags[0x06ED - kArabicBase] |= kIqlab;
+
+    flags[0x0628 - kArabicBase] |= kQalqala;                // beh
+    flags[0x062C - kArabicBase] |= kQalqala;                // jeem
+    flags[0x062F - kArabicBase] |= kQalqala;                // dal
+    flags[0x0637 - kArabicBase] |= kQalqala | kHeavy;       // tah
+    flags[0x0642 - kArabicBase] |= kQalqala | kHeavy;       // qaf
+    flags[0x062E - kArabicBase] |= kHeavy;                  // khah
+    flags[0x0635 - kArabicBase] |= kHeavy;                  // sad
+    flags[0x0636 - kArabicBase] |= kHeavy;                  // dad
+    flags[0x0638 - kArabicBase] |= kHeavy;                  // zah
+    flags[0x063A - kArabicBase] |= kHeavy;                  // ghain
+
+    flags[0x0621 - kArabicBase] |= kHamza;
+    flags[0x0622 - kArabicBase] |= kHamza | kMaddah;  // Precomposed alef with madda
+    flags[0x0623 - kArabicBase] |= kHamza;
+    flags[0x0624 - kArabicBase] |= kHamza;
+    flags[0x0625 - kArabicBase] |= kHamza;
+    flags[0x0626 - kArabicBase] |= kHamza;
+
+    flags[0x0646 - kArabicBase] |= kNoon;
+    flags[0x0645 - kArabicBase] |= kMeem;
+    flags[0x0631 - kArabicBase] |= kRa;
+    flags[0x0644 - kArabicBase] |= kLam;
+    flags[0x0671 - kArabicBase] |= kAlefWasla;
+
+    return flags;
+}
+
+constexpr std::array<uint32_t, 256> kArabicFlags = makeArabicFlags();
+
+inline uint32_t codePointFlags(uint32_t cp) {
+    if (cp >= kArabicBase && cp < kArabicBase + 256) {
+        return kArabicFlags[cp - kArabicBase];
+    }
+    if (cp >= 0x08F0 && cp <= 0x08F2) {
+        // Open fathatan, dammatan, kasratan
+        return kMark | kVowel | kTanween | kOpenTanween | (cp != 0x08F2 ? uint32_t(kOpensMouth) : 0u);
+    }
+    if (cp >= 0x08D3 && cp <= 0x08FF) {
+        return kMark;
+    }
+    return 0;
+}
+
+// A base letter and the marks that follow it
+struct LetterUnit {
+    uint32_t start;
+    uint32_t end;
+    uint32_t letter;        // Flags of the base
+    uint32_t marks;         // Union of the marks' flags
+    int next;               // Next letter unit in the same phrase, or -1
+    bool nextInWord;        // next follows without a word break
+    bool linked;            // The unit before is in the same phrase (its next is this one)
+};
+
+bool hasVowel(const LetterUnit& unit) {
+    return (unit.marks & (kVowel | kSukun | kShadda)) != 0;
+}
+
+TajweedClass classify(const std::vector<LetterUnit>& units, size_t index) {
+    const LetterUnit& unit = units[index];
+    const LetterUnit* next = unit.next >= 0 ? &units[unit.next] : nullptr;
+
+    // Madd: the maddah sign's length depends on what follows
+    if ((unit.letter | unit.marks) & kMaddah) {
+        if (next && unit.nextInWord && (next->marks & (kShadda | kSukun))) return TajweedClass::Red4;
+        if (next && unit.nextInWord && (next->letter & kHamza)) return TajweedClass::Red3;
+        if (next && !unit.nextInWord && (next->letter & kHamza)) return TajweedClass::Red2;
+        return TajweedClass::Red1;
+    }
+
+    // Ghunna of a doubled noon or meem
+    if ((unit.letter & (kNoon | kMeem)) && (unit.marks & kShadda)) return TajweedClass::Green;
+
+    // Iqlab and tanween merged into or hidden before the next letter
+    if (unit.marks & (kIqlab | kOpenTanween)) return TajweedClass::Green;
+
+    // Noon sakin without a sukun: idgham/ikhfa (no ghunna before lam and ra)
+    if ((unit.letter & kNoon) && !hasVowel(unit) && next) {
+        return (next->letter & (kLam | kRa)) ? TajweedClass::LGray : TajweedClass::Green;
+    }
+
+    // Meem sakin without a sukun: ikhfa/idgham shafawi
+    if ((unit.letter & kMeem) && !hasVowel(unit) && next) return TajweedClass::Green;
+
+    if ((unit.letter & kQalqala) && (unit.marks & kSukun)) return TajweedClass::LKalkala;
+
+    // Silent letters: marked with a small zero, hamzat wasl inside a phrase
+    // (pronounced where reading starts: the text start or after a marker),
+    // and the lam of al- before a sun letter (which carries the shadda)
+    if (unit.marks & kSilent) return TajweedClass::LGray;
+    if ((unit.letter & kAlefWasla) && unit.linked) return TajweedClass::LGray;
+    if ((unit.letter & kLam) && !hasVowel(unit) && next && unit.nextInWord && (next->marks & kShadda)) {
+        return TajweedClass::LGray;
+    }
+
+    if (unit.letter & kHeavy) return TajweedClass::Tafkim;
+    if ((unit.letter & kRa) && (unit.marks & kOpensMouth)) return TajweedClass::Tafkim;
+
+    return TajweedClass::None;
+}
+
+} // namespace
+
+void quranClassifyTajweed(const char* text, uint32_t size, std::vector<uint8_t>* out) {
+    out->assign(size, static_cast<uint8_t>(TajweedClass::None));
+
+    // Group code points into letter units; word and phrase breaks link each
+    // unit to the letter after it
+    std::vector<LetterUnit> units;
+    bool wordBreak = false;
+    bool phraseBreak = false;
+    uint32_t offset = 0;
+
+    while (offset < size) {
+        uint32_t start = offset;
+        uint32_t cp = quranDecodeUtf8(text, size, &offset);
+        uint32_t flags = codePointFlags(cp);
+
+        if (flags & kMark) {
+            if (!units.empty() && units.back().end == start) {
+                units.back().marks |= flags;
+                units.back().end = offset;
+            }
+            continue;
+        }
+
+        if (flags & kLetter) {
+            const bool linked = !units.empty() && !phraseBreak;
+            if (linked) {
+                units.back().next = static_cast<int>(units.size());
+                units.back().nextInWord = !wordBreak;
+            }
+            units.push_back({start, offset, flags, 0, -1, false, linked});
+            wordBreak = false;
+            phraseBreak = false;
+        } else if (flags & kWordPart) {
+            // Tatweel carries marks for the letter before it
+            if (!units.empty() && units.back().end == start) {
+                units.back().end = offset;
+            }
+        } else if (quranIsWhitespace(cp)) {
+            wordBreak = true;
+        } else {
+            // Ayah markers and other signs: a pause, no rule crosses it
+            wordBreak = true;
+            phraseBreak = true;
+        }
+    }
+
+    for (size_t i = 0; i < units.size(); i++) {
+        uint8_t tajweedClass = static_cast<uint8_t>(classify(units, i));
+        for (uint32_t b = units[i].start; b < units[i].end; b++) {
+            (*out)[b] = tajweedClass;
+        }
+    }
+}
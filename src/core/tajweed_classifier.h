@@ -0,0 +1,39 @@
+/**
+ * Tajweed classifier - rule-based tajweed color classes for the page text
+ *
+ * Fonts with embedded tajweed (GPOS lookups that encode a color per glyph)
+ * don't need this. DigitalKhattV2 has none, and the web app colors it with
+ * regular expressions over the text (tajweed.service.ts). This classifier
+ * implements those rules without regexes: code points are mapped through a
+ * compile-time flag table, grouped into letter units (a base letter and its
+ * marks), and each unit is classified from its own flags and those of the
+ * next letter. The renderer runs it once when it loads the text, over each
+ * surah's lines joined with newlines, so rules see across line and page
+ * breaks.
+ */
+
+#ifndef QURAN_RENDERER_TAJWEED_CLASSIFIER_H
+#define QURAN_RENDERER_TAJWEED_CLASSIFIER_H
+
+#include <cstdint>
+#include <vector>
+
+// Color categories of the DigitalKhatt web tajweed rules
+enum class TajweedClass : uint8_t {
+    None = 0,
+    Green = 1,      // Ghunna, idgham and ikhfa (noon/meem, tanween, iqlab)
+    Tafkim = 2,     // Heavy letters (dark blue)
+    LGray = 3,      // Letters written but not pronounced
+    LKalkala = 4,   // Qalqala (light blue)
+    Red1 = 5,       // Madd of 2 counts where lengthening is permitted
+    Red2 = 6,       // Madd munfasil (hamza in the next word)
+    Red3 = 7,       // Madd muttasil (hamza in the same word)
+    Red4 = 8,       // Madd lazim (followed by shadda or sukun)
+    Count = 9,
+};
+
+// Classifies a UTF-8 line: out gets one TajweedClass per byte, every byte of
+// a letter unit (base and marks) sharing the unit's class
+void quranClassifyTajweed(const char* text, uint32_t size, std::vector<uint8_t>* out);
+
+#endif // QURAN_RENDERER_TAJWEED_CLASSIFIER_H
@@ -0,0 +1,157 @@
+/**
+ * Test: Glyph Rasterizer
+ *
+ * Compares the signed-area coverage of GlyphRasterizer with a 16x16
+ * supersampled nonzero-winding reference on polygons shaped like glyph
+ * parts: fractional edges, curves, holes and overlapping contours.
+ */
+
+#include "glyph_rasterizer.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+static int passed = 0;
+static int total = 0;
+
+void check(bool condition, const char* message) {
+    total++;
+    if (condition) {
+        passed++;
+        printf("[\033[0;32mPASS\033[0m] %s\n", message);
+    } else {
+        printf("[\033[0;31mFAIL\033[0m] %s\n", message);
+    }
+}
+
+struct Point {
+    float x;
+    float y;
+};
+
+typedef std::vector<std::vector<Point>> Shape;
+
+static int winding(const Shape& shape, float px, float py) {
+    int wind = 0;
+    for (const auto& contour : shape) {
+        for (size_t i = 0; i < contour.size(); i++) {
+            const Point& a = contour[i];
+            const Point& b = contour[(i + 1) % contour.size()];
+            if ((a.y <= py) == (b.y <= py)) continue;
+            float x = a.x + (py - a.y) * (b.x - a.x) / (b.y - a.y);
+            if (x > px) wind += (b.y > a.y) ? 1 : -1;
+        }
+    }
+    return wind;
+}
+
+static std::vector<uint8_t> reference(const Shape& shape, int width, int height) {
+    const int samples = 16;
+    std::vector<uint8_t> out(static_cast<size_t>(width) * height);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            int inside = 0;
+            for (int sy = 0; sy < samples; sy++) {
+                for (int sx = 0; sx < samples; sx++) {
+                    float px = x + (sx + 0.5f) / samples;
+                    float py = y + (sy + 0.5f) / samples;
+                    if (winding(shape, px, py) != 0) inside++;
+                }
+            }
+            out[static_cast<size_t>(y) * width + x] =
+                static_cast<uint8_t>(inside * 255 / (samples * samples));
+        }
+    }
+    return out;
+}
+
+static std::vector<uint8_t> rasterize(const Shape& shape, int width, int height) {
+    GlyphRasterizer rasterizer;
+    rasterizer.reset(width, height);
+    for (const auto& contour : shape) {
+        for (size_t i = 0; i < contour.size(); i++) {
+            const Point& a = contour[i];
+            const Point& b = contour[(i + 1) % contour.size()];
+            rasterizer.line(a.x, a.y, b.x, b.y);
+        }
+    }
+    std::vector<uint8_t> out(static_cast<size_t>(width) * height);
+    rasterizer.coverage(out.data(), width);
+    return out;
+}
+
+// Max and mean absolute difference, in coverage levels (0-255)
+static void compare(const Shape& shape, int width, int height, int* maxDiff, double* meanDiff) {
+    std::vector<uint8_t> expected = reference(shape, width, height);
+    std::vector<uint8_t> actual = rasterize(shape, width, height);
+    long sum = 0;
+    *maxDiff = 0;
+    for (size_t i = 0; i < expected.size(); i++) {
+        int diff = abs(int(expected[i]) - int(actual[i]));
+        *maxDiff = diff > *maxDiff ? diff : *maxDiff;
+        sum += diff;
+    }
+    *meanDiff = double(sum) / expected.size();
+}
+
+static std::vector<Point> rect(float x0, float y0, float x1, float y1) {
+    return {{x0, y0}, {x1, y0}, {x1, y1}, {x0, y1}};
+}
+
+static std::vector<Point> circle(float cx, float cy, float r, bool clockwise) {
+    std::vector<Point> points;
+    for (int i = 0; i < 64; i++) {
+        float t = 2.0f * 3.14159265f * i / 64 * (clockwise ? 1.0f : -1.0f);
+        points.push_back({cx + r * cosf(t), cy + r * sinf(t)});
+    }
+    return points;
+}
+
+int main() {
+    printf("\n");
+    printf("============================================\n");
+    printf(" Glyph Rasterizer Test\n");
+    printf("============================================\n");
+    printf("\n");
+
+    int maxDiff;
+    double meanDiff;
+
+    compare({rect(4, 4, 20, 12)}, 24, 16, &maxDiff, &meanDiff);
+    check(maxDiff == 0, "Pixel-aligned rectangle is exact");
+
+    compare({rect(3.3f, 2.7f, 17.6f, 11.2f)}, 24, 16, &maxDiff, &meanDiff);
+    check(maxDiff <= 16 && meanDiff < 1.0, "Fractional edges match the reference");
+
+    compare({{{2, 1}, {21, 6}, {7, 14.5f}}}, 24, 16, &maxDiff, &meanDiff);
+    check(maxDiff <= 16 && meanDiff < 1.0, "Sloped edges match the reference");
+
+    compare({circle(12.3f, 11.7f, 9.4f, true)}, 24, 24, &maxDiff, &meanDiff);
+    check(maxDiff <= 16 && meanDiff < 1.0, "Flattened curve matches the reference");
+
+    // A counter (the hole of a letter) winds the other way
+    compare({circle(12, 12, 10, true), circle(12, 12, 5.5f, false)}, 24, 24, &maxDiff, &meanDiff);
+    check(maxDiff <= 16 && meanDiff < 1.0, "Reversed inner contour cuts a hole");
+
+    // Overlapping contours of the same direction (variable-font outlines)
+    // fill once; only pixels where two edges cross may differ
+    compare({rect(2.5f, 2.5f, 14.5f, 14.5f), rect(8.25f, 6.75f, 21.5f, 18.5f)}, 24, 24, &maxDiff, &meanDiff);
+    check(maxDiff <= 64 && meanDiff < 1.0, "Overlapping contours use nonzero fill");
+
+    // Wider than one vector, odd width for the scalar tail
+    compare({circle(40.5f, 9.5f, 8, true), rect(1.2f, 3.4f, 74.8f, 6.1f)}, 77, 20, &maxDiff, &meanDiff);
+    check(maxDiff <= 64 && meanDiff < 1.0, "Rows longer than a vector accumulate across chunks");
+
+    // Points past the area are clamped, not written out of bounds
+    compare({rect(-3, -2, 30, 9)}, 24, 16, &maxDiff, &meanDiff);
+    check(maxDiff == 0, "Outline larger than the area is clipped");
+
+    printf("\n");
+    printf("============================================\n");
+    printf(" Test Results: %d/%d passed\n", passed, total);
+    printf("============================================\n");
+    printf("\n");
+
+    return passed == total ? 0 : 1;
+}
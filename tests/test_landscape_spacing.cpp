@@ -235,7 +235,9 @@ bool test_with_actual_renderer() {
         0,      // fontSize (auto)
         false,  // useForeground
         0.0f,   // lineHeightDivisor
-        -1.0f   // topMarginLines (auto)
+        -1.0f,  // topMarginLines (auto)
+        QURAN_QUALITY_DEFAULT,
+        QURAN_CLEAR_FULL
     };
     
     // Render page 0 in landscape mode
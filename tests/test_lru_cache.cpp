@@ -0,0 +1,67 @@
+/**
+ * Test: LRU Cache
+ *
+ * Verifies recency order, byte-budget eviction and replacement in the
+ * LruCache used for the renderer's shaped-string cache.
+ */
+
+#include "lru_cache.h"
+#include <stdio.h>
+#include <string>
+
+static int passed = 0;
+static int total = 0;
+
+void check(bool condition, const char* message) {
+    total++;
+    if (condition) {
+        passed++;
+        printf("[\033[0;32mPASS\033[0m] %s\n", message);
+    } else {
+        printf("[\033[0;31mFAIL\033[0m] %s\n", message);
+    }
+}
+
+int main() {
+    printf("\n");
+    printf("============================================\n");
+    printf(" LRU Cache Test\n");
+    printf("============================================\n");
+    printf("\n");
+
+    LruCache<std::string, int> cache(100);
+
+    cache.put("a", std::make_shared<int>(1), 40);
+    cache.put("b", std::make_shared<int>(2), 40);
+    check(cache.size() == 2 && cache.bytes() == 80, "Entries within budget are kept");
+
+    // Touch "a" so "b" becomes least recently used
+    auto a = cache.get("a");
+    check(a && *a == 1, "Cached value is returned");
+
+    cache.put("c", std::make_shared<int>(3), 40);
+    check(!cache.get("b") && cache.get("a") && cache.get("c"),
+          "Least recently used entry is evicted over budget");
+    check(cache.bytes() == 80, "Evicted bytes are released");
+
+    cache.put("a", std::make_shared<int>(10), 20);
+    auto replaced = cache.get("a");
+    check(replaced && *replaced == 10 && cache.bytes() == 60, "Put replaces an existing key");
+
+    cache.put("huge", std::make_shared<int>(4), 200);
+    check(!cache.get("huge") && cache.size() == 2, "Values larger than the budget are not cached");
+
+    // A value handed out survives its eviction
+    auto held = cache.get("c");
+    cache.clear();
+    check(held && *held == 3 && cache.size() == 0 && cache.bytes() == 0,
+          "Clear empties the cache without invalidating held values");
+
+    printf("\n");
+    printf("============================================\n");
+    printf(" Test Results: %d/%d passed\n", passed, total);
+    printf("============================================\n");
+    printf("\n");
+
+    return passed == total ? 0 : 1;
+}
@@ -0,0 +1,119 @@
+/**
+ * Test: Juz / Hizb / Rub Navigation Tables
+ *
+ * Verifies the generated RUB_LOCATIONS and PAGE_RUBS tables in
+ * quran_metadata.h against PAGE_LOCATIONS and the known juz start pages.
+ */
+
+#include "quran_metadata.h"
+#include <stdio.h>
+
+// Page numbers (1-indexed, as printed in the mushaf) where each juz starts
+static const int JUZ_START_PAGES[30] = {
+    1, 22, 42, 62, 82, 102, 121, 142, 162, 182,
+    201, 222, 242, 262, 282, 302, 322, 342, 362, 382,
+    402, 422, 442, 462, 482, 502, 522, 542, 562, 582
+};
+
+static int passed = 0;
+static int total = 0;
+
+void check(bool condition, const char* message) {
+    total++;
+    if (condition) {
+        passed++;
+        printf("[\033[0;32mPASS\033[0m] %s\n", message);
+    } else {
+        printf("[\033[0;31mFAIL\033[0m] %s\n", message);
+    }
+}
+
+// True when (surahA, ayahA) comes before or at (surahB, ayahB)
+static bool atOrBefore(int surahA, int ayahA, int surahB, int ayahB) {
+    return surahA < surahB || (surahA == surahB && ayahA <= ayahB);
+}
+
+int main() {
+    printf("\n");
+    printf("============================================\n");
+    printf(" Navigation Tables Test\n");
+    printf("============================================\n");
+    printf("\n");
+
+    // Juz start pages
+    bool juzPagesOk = true;
+    for (int juz = 0; juz < QURAN_JUZ_COUNT; juz++) {
+        if (RUB_LOCATIONS[juz * 8].pageIndex != JUZ_START_PAGES[juz] - 1) {
+            printf("       Juz %d starts on page %d, expected %d\n",
+                   juz + 1, RUB_LOCATIONS[juz * 8].pageIndex + 1, JUZ_START_PAGES[juz]);
+            juzPagesOk = false;
+        }
+    }
+    check(juzPagesOk, "Juz start pages match the Madina mushaf");
+
+    // Rub starts are valid ayahs in mushaf order
+    bool orderOk = true;
+    for (int rub = 0; rub < QURAN_RUB_COUNT; rub++) {
+        const RubLocation& loc = RUB_LOCATIONS[rub];
+        if (loc.surahNumber < 1 || loc.surahNumber > QURAN_SURAH_COUNT ||
+            loc.ayahNumber < 1 || loc.ayahNumber > SURAH_DATA[loc.surahNumber].ayahCount) {
+            orderOk = false;
+        }
+        if (rub > 0 && atOrBefore(loc.surahNumber, loc.ayahNumber,
+                                  RUB_LOCATIONS[rub - 1].surahNumber, RUB_LOCATIONS[rub - 1].ayahNumber)) {
+            orderOk = false;
+        }
+    }
+    check(orderOk, "Rub starts are valid and strictly increasing");
+
+    // Each rub's page is the one containing its first ayah
+    bool rubPagesOk = true;
+    for (int rub = 0; rub < QURAN_RUB_COUNT; rub++) {
+        const RubLocation& loc = RUB_LOCATIONS[rub];
+        int page = loc.pageIndex;
+        const PageLocation& start = PAGE_LOCATIONS[page];
+        if (!atOrBefore(start.surahNumber, start.ayahNumber, loc.surahNumber, loc.ayahNumber)) {
+            rubPagesOk = false;
+        }
+        if (page + 1 < QURAN_PAGE_COUNT) {
+            const PageLocation& next = PAGE_LOCATIONS[page + 1];
+            if (atOrBefore(next.surahNumber, next.ayahNumber, loc.surahNumber, loc.ayahNumber)) {
+                rubPagesOk = false;
+            }
+        }
+    }
+    check(rubPagesOk, "Rub pages contain the rub's first ayah");
+
+    // Page -> rub is the last rub starting on or before the page
+    bool pageRubsOk = true;
+    for (int page = 0; page < QURAN_PAGE_COUNT; page++) {
+        int rub = PAGE_RUBS[page];
+        if (rub >= QURAN_RUB_COUNT || RUB_LOCATIONS[rub].pageIndex > page) {
+            pageRubsOk = false;
+        }
+        if (rub + 1 < QURAN_RUB_COUNT && RUB_LOCATIONS[rub + 1].pageIndex <= page) {
+            pageRubsOk = false;
+        }
+        if (page > 0 && rub < PAGE_RUBS[page - 1]) {
+            pageRubsOk = false;
+        }
+    }
+    check(pageRubsOk, "Page rubs are the last rub starting on each page");
+
+    // Round trip: a juz's start page belongs to that juz
+    bool roundTripOk = true;
+    for (int juz = 0; juz < QURAN_JUZ_COUNT; juz++) {
+        if (PAGE_RUBS[RUB_LOCATIONS[juz * 8].pageIndex] / 8 != juz) {
+            roundTripOk = false;
+        }
+    }
+    check(roundTripOk, "Juz start pages map back to their juz");
+
+    printf("\n");
+    printf("============================================\n");
+    printf(" Test Results: %d/%d passed\n", passed, total);
+    printf("============================================\n");
+    printf("\n");
+
+    return passed == total ? 0 : 1;
+}
@@ -0,0 +1,100 @@
+/**
+ * Test: Tajweed Classifier
+ *
+ * Verifies the rule-based tajweed classes of known words, one or more per
+ * TajweedClass, for fonts without embedded tajweed colors.
+ */
+
+#include "tajweed_classifier.h"
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+static int passed = 0;
+static int total = 0;
+
+void check(bool condition, const char* message) {
+    total++;
+    if (condition) {
+        passed++;
+        printf("[\033[0;32mPASS\033[0m] %s\n", message);
+    } else {
+        printf("[\033[0;31mFAIL\033[0m] %s\n", message);
+    }
+}
+
+// Class of every byte of the first occurrence of letter (a base letter and
+// any marks) in text, or -1 when the bytes disagree or letter is missing
+static int classOf(const char* text, const char* letter) {
+    std::vector<uint8_t> classes;
+    quranClassifyTajweed(text, static_cast<uint32_t>(strlen(text)), &classes);
+
+    const char* found = strstr(text, letter);
+    if (!found) return -1;
+    size_t start = static_cast<size_t>(found - text);
+    int result = classes[start];
+    for (size_t i = start; i < start + strlen(letter); i++) {
+        if (classes[i] != result) return -1;
+    }
+    return result;
+}
+
+static void expect(const char* text, const char* letter, TajweedClass expected, const char* message) {
+    int actual = classOf(text, letter);
+    check(actual == static_cast<int>(expected), message);
+    if (actual != static_cast<int>(expected)) {
+        printf("       %s / %s: expected %d, got %d\n", text, letter, static_cast<int>(expected), actual);
+    }
+}
+
+int main() {
+    printf("\n");
+    printf("============================================\n");
+    printf(" Tajweed Classifier Test\n");
+    printf("============================================\n");
+    printf("\n");
+
+    expect("بَ", "بَ", TajweedClass::None, "None: letter without a rule");
+
+    expect("إِنَّ", "نَّ", TajweedClass::Green, "Green: ghunna of a doubled noon");
+    expect("ثُمَّ", "مَّ", TajweedClass::Green, "Green: ghunna of a doubled meem");
+    expect("مِن قَبْلِ", "ن", TajweedClass::Green, "Green: ikhfa of noon sakin");
+    expect("عَلِيمٌۢ بِذَاتِ", "مٌۢ", TajweedClass::Green, "Green: iqlab (small meem)");
+
+    expect("صِرَٰطَ", "صِ", TajweedClass::Tafkim, "Tafkim: heavy letter (sad)");
+    expect("رَبِّ", "رَ", TajweedClass::Tafkim, "Tafkim: ra with fatha");
+    expect("رِجَالٌ", "رِ", TajweedClass::None, "None: ra with kasra is light");
+
+    expect("مِن لَّدُنْهُ", "ن", TajweedClass::LGray, "LGray: noon merged into lam without ghunna");
+    expect("قَالُوٓا۟", "ا۟", TajweedClass::LGray, "LGray: alef marked with a small zero");
+    expect("بِسْمِ ٱللَّهِ", "ٱ", TajweedClass::LGray, "LGray: hamzat wasl inside a phrase");
+    expect("ٱلْمُفْلِحُونَ", "ٱ", TajweedClass::None, "Hamzat wasl starting the text is pronounced");
+    expect("ٱلشَّمْسِ", "ل", TajweedClass::LGray, "LGray: lam of al- before a sun letter");
+    expect("ٱلْقَمَرِ", "لْ", TajweedClass::None, "None: lam of al- before a moon letter");
+
+    expect("يَدْخُلُونَ", "دْ", TajweedClass::LKalkala, "LKalkala: dal with sukun");
+    expect("يَقْطَعُونَ", "قْ", TajweedClass::LKalkala, "LKalkala: qaf with sukun");
+
+    expect("قَالُوٓا۟", "وٓ", TajweedClass::Red1, "Red1: maddah before a plain letter");
+    expect("بِمَآ أُنزِلَ", "آ", TajweedClass::Red2, "Red2: madd munfasil (hamza in the next word)");
+    expect("ٱلسَّمَآءِ", "آ", TajweedClass::Red3, "Red3: madd muttasil (hamza in the same word)");
+    expect("ٱلضَّآلِّينَ", "آ", TajweedClass::Red4, "Red4: madd lazim (shadda follows)");
+
+    // No rule crosses an end-of-ayah marker
+    expect("بِمَآ ۝٥ أُنزِلَ", "آ", TajweedClass::Red1, "Madd before an ayah marker ignores the next hamza");
+    expect("بِمَآ ۝٥ ٱلْحَمْدُ", "ٱ", TajweedClass::None, "Hamzat wasl after an ayah marker is pronounced");
+
+    // Lines are joined with newlines: rules see the next line's first letter
+    expect("مِن\nقَبْلِ", "ن", TajweedClass::Green, "Noon sakin at a line end sees the next line");
+    expect("بِمَآ\nأُنزِلَ", "آ", TajweedClass::Red2, "Madd at a line end sees the hamza on the next line");
+    expect("بِسْمِ\nٱللَّهِ", "ٱ", TajweedClass::LGray, "Hamzat wasl starting a continued line is silent");
+
+    printf("\n");
+    printf("============================================\n");
+    printf(" Test Results: %d/%d passed\n", passed, total);
+    printf("============================================\n");
+    printf("\n");
+
+    return passed == total ? 0 : 1;
+}
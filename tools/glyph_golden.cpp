@@ -0,0 +1,158 @@
+// Golden comparison of GlyphRasterizer against Skia's anti-aliased path filler.
+// Every glyph in the range is filled by both at the same size and subpixel
+// offset; the run fails when any glyph differs by more than the tolerance.
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <hb.h>
+
+#include "SkCanvas.h"
+#include "SkPathBuilder.h"
+
+#include "glyph_rasterizer.h"
+#include "hb_skia_canvas.h"
+
+struct GlyphDiff {
+    int maxDiff = 0;
+    double meanDiff = 0;
+};
+
+int main(int argc, char** argv) {
+    std::string fontPath = "android/src/main/assets/fonts/digitalkhatt.otf";
+    float size = 48.0f;
+    unsigned firstGlyph = 1;
+    unsigned glyphCount = 0;        // 0 = through the last glyph
+    int maxDiffAllowed = 32;        // Coverage levels (0-255)
+    double meanDiffAllowed = 1.0;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--font") == 0 && i + 1 < argc) {
+            fontPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--size") == 0 && i + 1 < argc) {
+            size = static_cast<float>(std::atof(argv[++i]));
+        } else if (std::strcmp(argv[i], "--first") == 0 && i + 1 < argc) {
+            firstGlyph = static_cast<unsigned>(std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--count") == 0 && i + 1 < argc) {
+            glyphCount = static_cast<unsigned>(std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--max-diff") == 0 && i + 1 < argc) {
+            maxDiffAllowed = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--mean-diff") == 0 && i + 1 < argc) {
+            meanDiffAllowed = std::atof(argv[++i]);
+        } else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--font <path>] [--size <px>] [--first <glyph>] [--count <n>]"
+                      << " [--max-diff <0-255>] [--mean-diff <levels>]\n";
+            return 2;
+        }
+    }
+
+    hb_blob_t* blob = hb_blob_create_from_file_or_fail(fontPath.c_str());
+    if (!blob) {
+        std::cerr << "Failed to read font: " << fontPath << "\n";
+        return 2;
+    }
+    hb_face_t* face = hb_face_create(blob, 0);
+    hb_font_t* font = hb_font_create(face);
+    const unsigned upem = hb_face_get_upem(face);
+    const unsigned totalGlyphs = hb_face_get_glyph_count(face);
+    const unsigned lastGlyph = glyphCount ? std::min(totalGlyphs, firstGlyph + glyphCount) : totalGlyphs;
+
+    const float scale = size / upem;
+    const float tolerance = 0.1f / scale;
+    const int pad = 2;
+
+    GlyphRasterizer rasterizer;
+    std::vector<float> segments;
+    std::vector<uint8_t> expected;
+    std::vector<uint8_t> actual;
+
+    double skiaMs = 0;
+    double rasterizerMs = 0;
+    unsigned compared = 0;
+    unsigned failed = 0;
+    GlyphDiff worst;
+    hb_codepoint_t worstGlyph = 0;
+
+    for (hb_codepoint_t glyph = firstGlyph; glyph < lastGlyph; ++glyph) {
+        hb_glyph_extents_t extents;
+        if (!hb_font_get_glyph_extents(font, glyph, &extents) || extents.width == 0 || extents.height == 0) {
+            continue;
+        }
+
+        // Font units (y up) to pixels (y down), with a different subpixel
+        // offset per glyph
+        const float offsetX = 0.125f * (glyph % 8);
+        const float offsetY = 0.125f * ((glyph / 8) % 8);
+        const int width = static_cast<int>(std::ceil(std::abs(extents.width) * scale)) + 2 * pad + 1;
+        const int height = static_cast<int>(std::ceil(std::abs(extents.height) * scale)) + 2 * pad + 1;
+        SkMatrix matrix = SkMatrix::Translate(pad + offsetX - extents.x_bearing * scale,
+                                              pad + offsetY + extents.y_bearing * scale);
+        matrix.preScale(scale, -scale);
+
+        expected.assign(static_cast<size_t>(width) * height, 0);
+        actual.assign(static_cast<size_t>(width) * height, 0);
+
+        auto start = std::chrono::steady_clock::now();
+        {
+            SkPathBuilder builder;
+            hb_skia_render_glyph(font, glyph, &builder);
+            auto canvas = SkCanvas::MakeRasterDirect(SkImageInfo::MakeA8(width, height), expected.data(), width);
+            canvas->setMatrix(matrix);
+            SkPaint paint;
+            paint.setAntiAlias(true);
+            canvas->drawPath(builder.detach(), paint);
+        }
+        auto middle = std::chrono::steady_clock::now();
+        {
+            segments.clear();
+            hb_skia_glyph_segments(font, glyph, matrix, tolerance, &segments);
+            rasterizer.reset(width, height);
+            for (size_t i = 0; i + 3 < segments.size(); i += 4) {
+                rasterizer.line(segments[i], segments[i + 1], segments[i + 2], segments[i + 3]);
+            }
+            rasterizer.coverage(actual.data(), width);
+        }
+        auto end = std::chrono::steady_clock::now();
+        skiaMs += std::chrono::duration<double, std::milli>(middle - start).count();
+        rasterizerMs += std::chrono::duration<double, std::milli>(end - middle).count();
+
+        GlyphDiff diff;
+        long sum = 0;
+        for (size_t i = 0; i < expected.size(); i++) {
+            int d = std::abs(int(expected[i]) - int(actual[i]));
+            diff.maxDiff = std::max(diff.maxDiff, d);
+            sum += d;
+        }
+        diff.meanDiff = double(sum) / expected.size();
+
+        compared++;
+        if (diff.maxDiff > maxDiffAllowed || diff.meanDiff > meanDiffAllowed) {
+            failed++;
+            std::cerr << "  glyph " << glyph << ": max diff " << diff.maxDiff
+                      << ", mean diff " << diff.meanDiff << "\n";
+        }
+        if (diff.maxDiff > worst.maxDiff) {
+            worst = diff;
+            worstGlyph = glyph;
+        }
+    }
+
+    hb_font_destroy(font);
+    hb_face_destroy(face);
+    hb_blob_destroy(blob);
+
+    std::cout << "Glyphs compared: " << compared << " at " << size << " px\n";
+    std::cout << "Worst glyph: " << worstGlyph << " (max diff " << worst.maxDiff
+              << ", mean diff " << worst.meanDiff << ")\n";
+    std::cout << "Skia: " << skiaMs << " ms, GlyphRasterizer: " << rasterizerMs << " ms\n";
+    std::cout << (failed ? "FAIL" : "PASS") << ": " << failed << " glyphs over tolerance\n";
+
+    return (compared == 0 || failed > 0) ? 1 : 0;
+}
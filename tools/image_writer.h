@@ -0,0 +1,262 @@
+// Image files for the render tools: PPM, QOI, PNG and raw RGBA.
+// Every writer takes an RGBA8888 buffer with a row stride, encodes into
+// memory and writes the file in one call.
+
+#ifndef QURAN_RENDERER_TOOLS_IMAGE_WRITER_H
+#define QURAN_RENDERER_TOOLS_IMAGE_WRITER_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifdef QURAN_TOOLS_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+enum class ImageFormat {
+    Ppm,
+    Qoi,
+    Png,
+    Raw,
+};
+
+inline const char* imageExtension(ImageFormat format) {
+    switch (format) {
+        case ImageFormat::Ppm: return "ppm";
+        case ImageFormat::Qoi: return "qoi";
+        case ImageFormat::Png: return "png";
+        case ImageFormat::Raw: return "rgba";
+    }
+    return "bin";
+}
+
+inline bool writeFileBytes(const std::string& path, const std::vector<uint8_t>& bytes) {
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) return false;
+    const bool written = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    return std::fclose(file) == 0 && written;
+}
+
+inline void appendBigEndian32(std::vector<uint8_t>& out, uint32_t value) {
+    out.push_back(static_cast<uint8_t>(value >> 24));
+    out.push_back(static_cast<uint8_t>(value >> 16));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+// Binary PPM (P6): RGB, alpha dropped
+inline void encodePPM(const uint8_t* rgba, int width, int height, int strideBytes, std::vector<uint8_t>& out) {
+    const std::string header = "P6\n" + std::to_string(width) + " " + std::to_string(height) + "\n255\n";
+    out.assign(header.begin(), header.end());
+    out.resize(header.size() + static_cast<size_t>(width) * height * 3);
+    uint8_t* dst = out.data() + header.size();
+    for (int y = 0; y < height; ++y) {
+        const uint8_t* row = rgba + static_cast<size_t>(y) * strideBytes;
+        for (int x = 0; x < width; ++x) {
+            *dst++ = row[x * 4];
+            *dst++ = row[x * 4 + 1];
+            *dst++ = row[x * 4 + 2];
+        }
+    }
+}
+
+// Raw RGBA8888, rows packed without padding
+inline void encodeRaw(const uint8_t* rgba, int width, int height, int strideBytes, std::vector<uint8_t>& out) {
+    const size_t rowBytes = static_cast<size_t>(width) * 4;
+    out.resize(rowBytes * height);
+    for (int y = 0; y < height; ++y) {
+        std::memcpy(out.data() + rowBytes * y, rgba + static_cast<size_t>(y) * strideBytes, rowBytes);
+    }
+}
+
+// QOI (qoiformat.org): lossless, about as small as PNG for rendered pages
+// and many times faster to encode
+inline void encodeQOI(const uint8_t* rgba, int width, int height, int strideBytes, std::vector<uint8_t>& out) {
+    out.clear();
+    out.reserve(14 + static_cast<size_t>(width) * height + 8);
+    const uint8_t magic[4] = {'q', 'o', 'i', 'f'};
+    out.insert(out.end(), magic, magic + 4);
+    appendBigEndian32(out, static_cast<uint32_t>(width));
+    appendBigEndian32(out, static_cast<uint32_t>(height));
+    out.push_back(4);   // RGBA
+    out.push_back(0);   // sRGB with linear alpha
+
+    uint8_t index[64][4] = {};
+    uint8_t previous[4] = {0, 0, 0, 255};
+    int run = 0;
+
+    for (int y = 0; y < height; ++y) {
+        const uint8_t* row = rgba + static_cast<size_t>(y) * strideBytes;
+        for (int x = 0; x < width; ++x) {
+            const uint8_t* px = row + x * 4;
+            if (std::memcmp(px, previous, 4) == 0) {
+                if (++run == 62) {
+                    out.push_back(static_cast<uint8_t>(0xC0 | (run - 1)));   // QOI_OP_RUN
+                    run = 0;
+                }
+                continue;
+            }
+            if (run > 0) {
+                out.push_back(static_cast<uint8_t>(0xC0 | (run - 1)));
+                run = 0;
+            }
+
+            const int slot = (px[0] * 3 + px[1] * 5 + px[2] * 7 + px[3] * 11) % 64;
+            if (std::memcmp(index[slot], px, 4) == 0) {
+                out.push_back(static_cast<uint8_t>(slot));                  // QOI_OP_INDEX
+            } else {
+                std::memcpy(index[slot], px, 4);
+                if (px[3] == previous[3]) {
+                    const int dr = static_cast<int8_t>(px[0] - previous[0]);
+                    const int dg = static_cast<int8_t>(px[1] - previous[1]);
+                    const int db = static_cast<int8_t>(px[2] - previous[2]);
+                    const int drg = dr - dg;
+                    const int dbg = db - dg;
+                    if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1) {
+                        out.push_back(static_cast<uint8_t>(0x40 | ((dr + 2) << 4) | ((dg + 2) << 2) | (db + 2)));
+                    } else if (dg >= -32 && dg <= 31 && drg >= -8 && drg <= 7 && dbg >= -8 && dbg <= 7) {
+                        out.push_back(static_cast<uint8_t>(0x80 | (dg + 32)));      // QOI_OP_LUMA
+                        out.push_back(static_cast<uint8_t>(((drg + 8) << 4) | (dbg + 8)));
+                    } else {
+                        out.push_back(0xFE);                                        // QOI_OP_RGB
+                        out.insert(out.end(), px, px + 3);
+                    }
+                } else {
+                    out.push_back(0xFF);                                            // QOI_OP_RGBA
+                    out.insert(out.end(), px, px + 4);
+                }
+            }
+            std::memcpy(previous, px, 4);
+        }
+    }
+    if (run > 0) {
+        out.push_back(static_cast<uint8_t>(0xC0 | (run - 1)));
+    }
+
+    const uint8_t end[8] = {0, 0, 0, 0, 0, 0, 0, 1};
+    out.insert(out.end(), end, end + 8);
+}
+
+inline uint32_t pngCrc(const uint8_t* data, size_t length, uint32_t crc = 0) {
+    static const std::array<uint32_t, 256> table = [] {
+        std::array<uint32_t, 256> entries{};
+        for (uint32_t n = 0; n < 256; n++) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; k++) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            entries[n] = c;
+        }
+        return entries;
+    }();
+    crc = ~crc;
+    for (size_t i = 0; i < length; i++) {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+inline void appendPngChunk(std::vector<uint8_t>& out, const char* type, const std::vector<uint8_t>& data) {
+    appendBigEndian32(out, static_cast<uint32_t>(data.size()));
+    const size_t start = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), data.begin(), data.end());
+    appendBigEndian32(out, pngCrc(out.data() + start, out.size() - start));
+}
+
+// zlib stream of uncompressed (stored) deflate blocks: valid everywhere,
+// used when zlib is missing or fails
+inline void encodeStoredZlib(const std::vector<uint8_t>& data, std::vector<uint8_t>& out) {
+    out.clear();
+    out.push_back(0x78);
+    out.push_back(0x01);
+    uint32_t a = 1, b = 0;
+    for (uint8_t byte : data) {
+        a = (a + byte) % 65521;
+        b = (b + a) % 65521;
+    }
+    for (size_t offset = 0; offset < data.size(); offset += 65535) {
+        const uint16_t length = static_cast<uint16_t>(std::min<size_t>(65535, data.size() - offset));
+        const uint16_t inverse = static_cast<uint16_t>(~length);
+        out.push_back(offset + length >= data.size() ? 1 : 0);   // Final block
+        out.push_back(static_cast<uint8_t>(length));
+        out.push_back(static_cast<uint8_t>(length >> 8));
+        out.push_back(static_cast<uint8_t>(inverse));
+        out.push_back(static_cast<uint8_t>(inverse >> 8));
+        out.insert(out.end(), data.begin() + offset, data.begin() + offset + length);
+    }
+    appendBigEndian32(out, (b << 16) | a);
+}
+
+// PNG, 8-bit RGBA. Rows use the Sub filter, which turns the flat runs of a
+// page into zeros. Compressed with zlib when the tools are built with it
+// and it succeeds, otherwise stored in uncompressed deflate blocks.
+inline void encodePNG(const uint8_t* rgba, int width, int height, int strideBytes, std::vector<uint8_t>& out) {
+    const size_t rowBytes = static_cast<size_t>(width) * 4;
+    std::vector<uint8_t> filtered((rowBytes + 1) * height);
+    for (int y = 0; y < height; ++y) {
+        const uint8_t* row = rgba + static_cast<size_t>(y) * strideBytes;
+        uint8_t* dst = filtered.data() + (rowBytes + 1) * y;
+        dst[0] = 1;     // Sub
+        std::memcpy(dst + 1, row, 4);
+        for (size_t i = 4; i < rowBytes; i++) {
+            dst[1 + i] = static_cast<uint8_t>(row[i] - row[i - 4]);
+        }
+    }
+
+    std::vector<uint8_t> idat;
+#ifdef QURAN_TOOLS_HAVE_ZLIB
+    uLongf compressedSize = compressBound(static_cast<uLong>(filtered.size()));
+    idat.resize(compressedSize);
+    if (compress2(idat.data(), &compressedSize, filtered.data(), static_cast<uLong>(filtered.size()),
+                  Z_BEST_SPEED) == Z_OK) {
+        idat.resize(compressedSize);
+    } else {
+        encodeStoredZlib(filtered, idat);
+    }
+#else
+    encodeStoredZlib(filtered, idat);
+#endif
+
+    const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    out.assign(signature, signature + 8);
+
+    std::vector<uint8_t> header;
+    appendBigEndian32(header, static_cast<uint32_t>(width));
+    appendBigEndian32(header, static_cast<uint32_t>(height));
+    header.push_back(8);    // Bit depth
+    header.push_back(6);    // RGBA
+    header.push_back(0);    // Deflate
+    header.push_back(0);    // Adaptive filtering
+    header.push_back(0);    // No interlace
+    appendPngChunk(out, "IHDR", header);
+    appendPngChunk(out, "IDAT", idat);
+    appendPngChunk(out, "IEND", {});
+}
+
+inline void encodeImage(ImageFormat format, const uint8_t* rgba, int width, int height, int strideBytes,
+                        std::vector<uint8_t>& out) {
+    switch (format) {
+        case ImageFormat::Ppm: encodePPM(rgba, width, height, strideBytes, out); break;
+        case ImageFormat::Qoi: encodeQOI(rgba, width, height, strideBytes, out); break;
+        case ImageFormat::Png: encodePNG(rgba, width, height, strideBytes, out); break;
+        case ImageFormat::Raw: encodeRaw(rgba, width, height, strideBytes, out); break;
+    }
+}
+
+inline bool writeImage(const std::string& path, ImageFormat format, const uint8_t* rgba,
+                       int width, int height, int strideBytes) {
+    std::vector<uint8_t> bytes;
+    encodeImage(format, rgba, width, height, strideBytes, bytes);
+    return writeFileBytes(path, bytes);
+}
+
+inline bool writePPM_RGBA8888(const std::string& path, const uint8_t* rgba, int width, int height, int strideBytes) {
+    return writeImage(path, ImageFormat::Ppm, rgba, width, height, strideBytes);
+}
+
+#endif // QURAN_RENDERER_TOOLS_IMAGE_WRITER_H
@@ -0,0 +1,313 @@
+// Renders a page range of the mushaf to image files for every combination
+// of font and page size, one renderer per font on every worker thread.
+// Reports throughput, per-page latency (render, encode and write) and the
+// process's peak memory.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#endif
+
+#include "quran/renderer.h"
+#include "image_writer.h"
+
+static bool readFile(const std::string& path, std::vector<uint8_t>& out) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    in.seekg(0, std::ios::end);
+    std::streamsize size = in.tellg();
+    if (size <= 0) return false;
+    in.seekg(0, std::ios::beg);
+    out.resize(static_cast<size_t>(size));
+    if (!in.read(reinterpret_cast<char*>(out.data()), size)) return false;
+    return true;
+}
+
+// Peak resident set size of the process in MiB, or -1 when unknown
+static double peakRssMiB() {
+#if defined(_WIN32)
+    return -1;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return -1;
+#if defined(__APPLE__)
+    return usage.ru_maxrss / (1024.0 * 1024.0);    // Bytes
+#else
+    return usage.ru_maxrss / 1024.0;               // KiB
+#endif
+#endif
+}
+
+struct ExportFont {
+    std::string name;               // File stem, the output subdirectory
+    std::vector<uint8_t> bytes;
+};
+
+struct PageSize {
+    int width;
+    int height;
+};
+
+int main(int argc, char** argv) {
+    std::vector<std::string> fontPaths;
+    std::string headerFontPath;
+    std::vector<PageSize> sizes;
+    std::string outDir = "build/export";
+    ImageFormat format = ImageFormat::Png;
+    int firstPage = 0;
+    int lastPage = 603;
+    int threadCount = static_cast<int>(std::thread::hardware_concurrency());
+    bool tajweed = true;
+    uint32_t backgroundColor = 0xFFFFFFFF;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--font") == 0 && i + 1 < argc) {
+            fontPaths.push_back(argv[++i]);
+        } else if (std::strcmp(argv[i], "--header-font") == 0 && i + 1 < argc) {
+            headerFontPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--size") == 0 && i + 1 < argc) {
+            PageSize size{0, 0};
+            if (std::sscanf(argv[++i], "%dx%d", &size.width, &size.height) != 2 ||
+                size.width <= 0 || size.height <= 0) {
+                std::cerr << "Invalid size: " << argv[i] << " (expected WIDTHxHEIGHT)\n";
+                return 2;
+            }
+            sizes.push_back(size);
+        } else if (std::strcmp(argv[i], "--first") == 0 && i + 1 < argc) {
+            firstPage = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--last") == 0 && i + 1 < argc) {
+            lastPage = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--format") == 0 && i + 1 < argc) {
+            const std::string name = argv[++i];
+            if (name == "png") {
+                format = ImageFormat::Png;
+            } else if (name == "qoi") {
+                format = ImageFormat::Qoi;
+            } else if (name == "raw") {
+                format = ImageFormat::Raw;
+            } else if (name == "ppm") {
+                format = ImageFormat::Ppm;
+            } else {
+                std::cerr << "Unknown format: " << name << "\n";
+                return 2;
+            }
+        } else if (std::strcmp(argv[i], "--outdir") == 0 && i + 1 < argc) {
+            outDir = argv[++i];
+        } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threadCount = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--background") == 0 && i + 1 < argc) {
+            backgroundColor = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 16));
+        } else if (std::strcmp(argv[i], "--no-tajweed") == 0) {
+            tajweed = false;
+        } else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--font <path>]... [--header-font <path>] [--size <WxH>]..."
+                      << " [--first <page>] [--last <page>] [--format png|qoi|raw|ppm]"
+                      << " [--outdir <path>] [--threads <n>] [--background <RRGGBBAA>] [--no-tajweed]\n";
+            return 2;
+        }
+    }
+
+    if (fontPaths.empty()) {
+        fontPaths.push_back("android/src/main/assets/fonts/digitalkhatt.otf");
+    }
+    if (sizes.empty()) {
+        sizes.push_back({1080, 1920});
+    }
+    if (threadCount <= 0) {
+        threadCount = 1;
+    }
+    if (firstPage < 0 || lastPage > 603 || firstPage > lastPage) {
+        std::cerr << "Invalid page range (pages are 0-603)\n";
+        return 2;
+    }
+
+    std::vector<ExportFont> fonts;
+    for (const std::string& path : fontPaths) {
+        ExportFont font;
+        font.name = std::filesystem::path(path).stem().string();
+        if (!readFile(path, font.bytes)) {
+            std::cerr << "Failed to read font: " << path << "\n";
+            return 2;
+        }
+        fonts.push_back(std::move(font));
+    }
+    std::vector<uint8_t> headerFontBytes;
+    if (!headerFontPath.empty() && !readFile(headerFontPath, headerFontBytes)) {
+        std::cerr << "Failed to read font: " << headerFontPath << "\n";
+        return 2;
+    }
+
+    std::error_code error;
+    for (const ExportFont& font : fonts) {
+        for (const PageSize& size : sizes) {
+            std::filesystem::create_directories(std::filesystem::path(outDir) / font.name /
+                (std::to_string(size.width) + "x" + std::to_string(size.height)), error);
+            if (error) {
+                std::cerr << "Failed to create output directory: " << error.message() << "\n";
+                return 2;
+            }
+        }
+    }
+
+    // Font-major, then size, then page: a worker's consecutive pages mostly
+    // share a renderer and a buffer, so each page clears only the previous
+    // page's ink (QURAN_CLEAR_DIRTY)
+    const int pagesPerSize = lastPage - firstPage + 1;
+    const int jobCount = static_cast<int>(fonts.size() * sizes.size()) * pagesPerSize;
+    threadCount = std::min(threadCount, jobCount);
+
+    std::vector<double> latencyMs(static_cast<size_t>(jobCount), -1.0);    // -1 = page failed
+    std::atomic<int> nextJob{0};
+    std::atomic<int> failures{0};
+
+    // A font whose renderer can't be created fails once; its remaining pages are skipped
+    std::vector<std::atomic<bool>> fontFailed(fonts.size());
+    for (auto& failed : fontFailed) failed = false;
+
+    auto worker = [&] {
+        std::vector<QuranRendererHandle> renderers(fonts.size(), nullptr);
+        std::vector<std::vector<uint8_t>> buffers(sizes.size());
+        std::vector<int> bufferFont(sizes.size(), -1);     // Font whose renderer drew the buffer last
+        std::vector<uint8_t> encoded;
+
+        for (int job = nextJob++; job < jobCount; job = nextJob++) {
+            const size_t fontIndex = static_cast<size_t>(job / (pagesPerSize * static_cast<int>(sizes.size())));
+            const size_t sizeIndex = static_cast<size_t>((job / pagesPerSize) % static_cast<int>(sizes.size()));
+            const int pageIndex = firstPage + job % pagesPerSize;
+            const PageSize& size = sizes[sizeIndex];
+
+            if (fontFailed[fontIndex]) {
+                failures++;
+                continue;
+            }
+            if (!renderers[fontIndex]) {
+                QuranFontData fontData;
+                fontData.data = fonts[fontIndex].bytes.data();
+                fontData.size = fonts[fontIndex].bytes.size();
+                renderers[fontIndex] = quran_renderer_create(&fontData);
+                if (!renderers[fontIndex]) {
+                    if (!fontFailed[fontIndex].exchange(true)) {
+                        std::cerr << "Failed to create renderer for " << fonts[fontIndex].name
+                                  << ", skipping its pages\n";
+                    }
+                    failures++;
+                    continue;
+                }
+                if (!headerFontBytes.empty()) {
+                    QuranFontData headerData;
+                    headerData.data = headerFontBytes.data();
+                    headerData.size = headerFontBytes.size();
+                    quran_renderer_load_surah_header_font(renderers[fontIndex], &headerData);
+                }
+            }
+
+            auto start = std::chrono::steady_clock::now();
+
+            const int stride = size.width * 4;
+            std::vector<uint8_t>& pixels = buffers[sizeIndex];
+            pixels.resize(static_cast<size_t>(stride) * size.height);
+
+            QuranPixelBuffer buffer;
+            buffer.pixels = pixels.data();
+            buffer.width = size.width;
+            buffer.height = size.height;
+            buffer.stride = stride;
+            buffer.format = QURAN_PIXEL_FORMAT_RGBA8888;
+
+            // The buffer is shared by this worker's renderers: one that didn't
+            // draw it last must not trust its record of the buffer's ink
+            if (bufferFont[sizeIndex] != static_cast<int>(fontIndex)) {
+                quran_renderer_forget_buffer(renderers[fontIndex], &buffer);
+                bufferFont[sizeIndex] = static_cast<int>(fontIndex);
+            }
+
+            QuranRenderConfig config = {};
+            config.tajweed = tajweed;
+            config.justify = true;
+            config.fontScale = 1.0f;
+            config.backgroundColor = backgroundColor;
+            config.topMarginLines = -1.0f;
+            config.quality = QURAN_QUALITY_HIGH;
+            config.clearMode = QURAN_CLEAR_DIRTY;
+            quran_renderer_draw_page(renderers[fontIndex], &buffer, pageIndex, &config);
+
+            char name[32];
+            std::snprintf(name, sizeof(name), "page-%03d.%s", pageIndex + 1, imageExtension(format));
+            const std::filesystem::path path = std::filesystem::path(outDir) / fonts[fontIndex].name /
+                (std::to_string(size.width) + "x" + std::to_string(size.height)) / name;
+            encodeImage(format, pixels.data(), size.width, size.height, stride, encoded);
+            if (!writeFileBytes(path.string(), encoded)) {
+                std::cerr << "Failed to write " << path.string() << "\n";
+                failures++;
+                continue;
+            }
+
+            std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+            latencyMs[static_cast<size_t>(job)] = elapsed.count();
+        }
+
+        for (QuranRendererHandle renderer : renderers) {
+            if (renderer) quran_renderer_destroy(renderer);
+        }
+    };
+
+    std::cout << "Exporting pages " << firstPage << "-" << lastPage << " for " << fonts.size()
+              << " font(s) at " << sizes.size() << " size(s) on " << threadCount << " thread(s)\n";
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int i = 1; i < threadCount; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    std::chrono::duration<double> wall = std::chrono::steady_clock::now() - start;
+
+    // Percentiles of the pages written; failed pages have no latency
+    std::vector<double> sorted;
+    for (double ms : latencyMs) {
+        if (ms >= 0) sorted.push_back(ms);
+    }
+    std::sort(sorted.begin(), sorted.end());
+    auto percentile = [&](double p) {
+        size_t index = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+        return sorted[std::min(index, sorted.size() - 1)];
+    };
+
+    const int written = static_cast<int>(sorted.size());
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Pages:    " << written << " in " << wall.count() << " s ("
+              << (written / wall.count()) << " pages/s)\n";
+    if (written > 0) {
+        std::cout << "Latency:  p50 " << percentile(0.50) << " ms, p99 " << percentile(0.99) << " ms\n";
+    }
+    const double rss = peakRssMiB();
+    if (rss >= 0) {
+        std::cout << "Peak RSS: " << rss << " MiB\n";
+    }
+    std::cout << "Output:   " << outDir << "\n";
+
+    if (failures > 0) {
+        std::cerr << failures << " page(s) failed\n";
+        return 1;
+    }
+    return 0;
+}
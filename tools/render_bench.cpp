@@ -0,0 +1,147 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "quran/renderer.h"
+
+static bool readFile(const std::string& path, std::vector<uint8_t>& out) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    in.seekg(0, std::ios::end);
+    std::streamsize size = in.tellg();
+    if (size <= 0) return false;
+    in.seekg(0, std::ios::beg);
+    out.resize(static_cast<size_t>(size));
+    if (!in.read(reinterpret_cast<char*>(out.data()), size)) return false;
+    return true;
+}
+
+struct BenchCase {
+    const char* name;
+    QuranRenderQuality quality;
+    QuranRenderPhase phase;
+    QuranClearMode clearMode;
+};
+
+int main(int argc, char** argv) {
+    std::string fontPath = "android/src/main/assets/fonts/digitalkhatt.otf";
+    int firstPage = 0;
+    int pageCount = 20;
+    int width = 1080;
+    int height = 1920;
+    int rounds = 3;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--font") == 0 && i + 1 < argc) {
+            fontPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--first") == 0 && i + 1 < argc) {
+            firstPage = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--pages") == 0 && i + 1 < argc) {
+            pageCount = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--width") == 0 && i + 1 < argc) {
+            width = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--height") == 0 && i + 1 < argc) {
+            height = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--rounds") == 0 && i + 1 < argc) {
+            rounds = std::atoi(argv[++i]);
+        } else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--font <path>] [--first <page>] [--pages <count>]"
+                      << " [--width <px>] [--height <px>] [--rounds <n>]\n";
+            return 2;
+        }
+    }
+
+    if (firstPage < 0 || pageCount <= 0 || firstPage + pageCount > 604 ||
+        width <= 0 || height <= 0 || rounds <= 0) {
+        std::cerr << "Invalid page range or size\n";
+        return 2;
+    }
+
+    std::vector<uint8_t> fontBytes;
+    if (!readFile(fontPath, fontBytes)) {
+        std::cerr << "Failed to read font: " << fontPath << "\n";
+        return 2;
+    }
+
+    QuranFontData fontData;
+    fontData.data = fontBytes.data();
+    fontData.size = static_cast<size_t>(fontBytes.size());
+
+    QuranRendererHandle renderer = quran_renderer_create(&fontData);
+    if (!renderer) {
+        std::cerr << "Failed to create renderer\n";
+        return 2;
+    }
+
+    const int stride = width * 4;
+    std::vector<uint8_t> pixels(static_cast<size_t>(stride) * height);
+
+    QuranPixelBuffer buffer;
+    buffer.pixels = pixels.data();
+    buffer.width = width;
+    buffer.height = height;
+    buffer.stride = stride;
+    buffer.format = QURAN_PIXEL_FORMAT_RGBA8888;
+
+    QuranRenderConfig config = {};
+    config.tajweed = true;
+    config.justify = true;
+    config.fontScale = 1.0f;
+    config.backgroundColor = 0xFFFFFFFF;
+    config.topMarginLines = -1.0f;
+
+    // Shaping is cached per line and width, so one untimed pass leaves only
+    // the fill cost that the quality levels change
+    quran_renderer_prepare_justification(renderer, firstPage, firstPage + pageCount - 1, width, &config);
+    for (int page = firstPage; page < firstPage + pageCount; ++page) {
+        quran_renderer_draw_page(renderer, &buffer, page, &config);
+    }
+
+    const BenchCase cases[] = {
+        {"draft", QURAN_QUALITY_DEFAULT, QURAN_RENDER_DRAFT, QURAN_CLEAR_FULL},
+        {"low", QURAN_QUALITY_LOW, QURAN_RENDER_FINAL, QURAN_CLEAR_FULL},
+        {"medium", QURAN_QUALITY_MEDIUM, QURAN_RENDER_FINAL, QURAN_CLEAR_FULL},
+        {"high", QURAN_QUALITY_HIGH, QURAN_RENDER_FINAL, QURAN_CLEAR_FULL},
+        {"zoom", QURAN_QUALITY_ZOOM, QURAN_RENDER_FINAL, QURAN_CLEAR_FULL},
+        // Same buffer page after page: refill the previous page's ink only
+        {"dirty", QURAN_QUALITY_HIGH, QURAN_RENDER_FINAL, QURAN_CLEAR_DIRTY},
+    };
+
+    std::cout << "Pages " << firstPage << "-" << (firstPage + pageCount - 1)
+              << " at " << width << "x" << height << ", best of " << rounds << " rounds\n\n";
+    std::cout << std::left << std::setw(10) << "case"
+              << std::right << std::setw(12) << "ms/page" << std::setw(12) << "pages/s" << "\n";
+
+    for (const BenchCase& bench : cases) {
+        config.quality = bench.quality;
+        config.clearMode = bench.clearMode;
+
+        double best = 0;
+        for (int round = 0; round < rounds; ++round) {
+            auto start = std::chrono::steady_clock::now();
+            for (int page = firstPage; page < firstPage + pageCount; ++page) {
+                quran_renderer_draw_page_phase(renderer, &buffer, page, &config, bench.phase);
+            }
+            std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+            if (round == 0 || elapsed.count() < best) {
+                best = elapsed.count();
+            }
+        }
+
+        const double msPerPage = best / pageCount;
+        std::cout << std::left << std::setw(10) << bench.name
+                  << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(12) << msPerPage << std::setw(12) << (1000.0 / msPerPage) << "\n";
+    }
+
+    quran_renderer_destroy(renderer);
+
+    return 0;
+}
@@ -8,6 +8,7 @@
 #include <vector>
 
 #include "quran/renderer.h"
+#include "image_writer.h"
 
 static bool readFile(const std::string& path, std::vector<uint8_t>& out) {
     std::ifstream in(path, std::ios::binary);
@@ -21,23 +22,6 @@ static bool readFile(const std::string& path, std::vector<uint8_t>& out) {
     return true;
 }
 
-static bool writePPM_RGBA8888(const std::string& path, const uint8_t* rgba, int width, int height, int strideBytes) {
-    std::ofstream out(path, std::ios::binary);
-    if (!out) return false;
-
-    out << "P6\n" << width << " " << height << "\n255\n";
-    for (int y = 0; y < height; ++y) {
-        const uint8_t* row = rgba + y * strideBytes;
-        for (int x = 0; x < width; ++x) {
-            const uint8_t* px = row + x * 4;
-            out.put(static_cast<char>(px[0]));
-            out.put(static_cast<char>(px[1]));
-            out.put(static_cast<char>(px[2]));
-        }
-    }
-    return true;
-}
-
 static inline bool nearColor(uint8_t r, uint8_t g, uint8_t b, uint8_t rr, uint8_t gg, uint8_t bb, int tol) {
     return std::abs(int(r) - int(rr)) <= tol && std::abs(int(g) - int(gg)) <= tol && std::abs(int(b) - int(bb)) <= tol;
 }
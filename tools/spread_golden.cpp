@@ -0,0 +1,137 @@
+// Golden comparison of quran_renderer_draw_spread against draw_page.
+// Each half of a spread must match the page drawn on its own at the half's
+// size. The left page is drawn by the renderer's second instance on its own
+// thread, so this catches state that the instance fails to share (such as
+// the Fatiha line widths of pages 0 and 1).
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "quran/renderer.h"
+
+static bool readFile(const std::string& path, std::vector<uint8_t>& out) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    in.seekg(0, std::ios::end);
+    std::streamsize size = in.tellg();
+    if (size <= 0) return false;
+    in.seekg(0, std::ios::beg);
+    out.resize(static_cast<size_t>(size));
+    if (!in.read(reinterpret_cast<char*>(out.data()), size)) return false;
+    return true;
+}
+
+// Pixels of a page-sized window of the spread that differ from the page
+static long countDiffs(const std::vector<uint8_t>& spread, int spreadStride, int x,
+                       const std::vector<uint8_t>& page, int width, int height) {
+    long diffs = 0;
+    for (int y = 0; y < height; ++y) {
+        const uint8_t* a = spread.data() + static_cast<size_t>(y) * spreadStride + x * 4;
+        const uint8_t* b = page.data() + static_cast<size_t>(y) * width * 4;
+        for (int i = 0; i < width; ++i) {
+            if (std::memcmp(a + i * 4, b + i * 4, 4) != 0) diffs++;
+        }
+    }
+    return diffs;
+}
+
+int main(int argc, char** argv) {
+    std::string fontPath = "android/src/main/assets/fonts/digitalkhatt.otf";
+    std::vector<int> spreads;
+    int width = 2560;
+    int height = 1600;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--font") == 0 && i + 1 < argc) {
+            fontPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--spread") == 0 && i + 1 < argc) {
+            spreads.push_back(std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--width") == 0 && i + 1 < argc) {
+            width = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--height") == 0 && i + 1 < argc) {
+            height = std::atoi(argv[++i]);
+        } else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--font <path>] [--spread <right page>]... [--width <px>] [--height <px>]\n";
+            return 2;
+        }
+    }
+
+    if (spreads.empty()) {
+        // Al-Fatiha and Al-Baqara's opening (circular line widths), and the last pages
+        spreads = {0, 602};
+    }
+    for (int rightPage : spreads) {
+        if (rightPage < 0 || rightPage > 603) {
+            std::cerr << "Invalid page: " << rightPage << "\n";
+            return 2;
+        }
+    }
+
+    // Must match quran_renderer_draw_spread
+    const int gutter = std::max(2, width / 40);
+    const int pageWidth = (width - gutter) / 2;
+    if (pageWidth <= 0 || height <= 0) {
+        std::cerr << "Invalid size\n";
+        return 2;
+    }
+
+    std::vector<uint8_t> fontBytes;
+    if (!readFile(fontPath, fontBytes)) {
+        std::cerr << "Failed to read font: " << fontPath << "\n";
+        return 2;
+    }
+
+    QuranFontData fontData;
+    fontData.data = fontBytes.data();
+    fontData.size = fontBytes.size();
+    QuranRendererHandle renderer = quran_renderer_create(&fontData);
+    if (!renderer) {
+        std::cerr << "Failed to create renderer\n";
+        return 2;
+    }
+
+    if (std::thread::hardware_concurrency() <= 1) {
+        std::cout << "Note: one core, both halves are drawn by the same instance\n";
+    }
+
+    QuranRenderConfig config = {};
+    config.tajweed = true;
+    config.justify = true;
+    config.fontScale = 1.0f;
+    config.backgroundColor = 0xFFFFFFFF;
+    config.topMarginLines = -1.0f;
+
+    std::vector<uint8_t> spreadPixels(static_cast<size_t>(width) * height * 4);
+    QuranPixelBuffer spreadBuffer = {spreadPixels.data(), width, height, width * 4, QURAN_PIXEL_FORMAT_RGBA8888};
+
+    std::vector<uint8_t> pagePixels(static_cast<size_t>(pageWidth) * height * 4);
+    QuranPixelBuffer pageBuffer = {pagePixels.data(), pageWidth, height, pageWidth * 4, QURAN_PIXEL_FORMAT_RGBA8888};
+
+    int failed = 0;
+    for (int rightPage : spreads) {
+        quran_renderer_draw_spread(renderer, &spreadBuffer, rightPage, &config);
+
+        const int halves[2][2] = {{rightPage, width - pageWidth}, {rightPage + 1, 0}};
+        for (const auto& half : halves) {
+            if (half[0] >= 604) continue;
+            quran_renderer_draw_page(renderer, &pageBuffer, half[0], &config);
+            const long diffs = countDiffs(spreadPixels, width * 4, half[1], pagePixels, pageWidth, height);
+            std::cout << "  page " << half[0] << (half[1] == 0 ? " (left): " : " (right): ")
+                      << diffs << " pixels differ\n";
+            if (diffs > 0) failed++;
+        }
+    }
+
+    quran_renderer_destroy(renderer);
+
+    std::cout << (failed ? "FAIL" : "PASS") << ": " << failed << " spread halves differ from draw_page\n";
+    return failed > 0 ? 1 : 0;
+}